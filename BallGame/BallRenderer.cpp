@@ -25,12 +25,25 @@ void BallRenderer::renderBalls(ge::SpriteBatch& spriteBatch, const std::vector<B
     GLint pUniform = m_program->getUniformLocation("P");
     glUniformMatrix4fv(pUniform, 1, GL_FALSE, &projectionMatrix[0][0]);
 
-    // Render all the balls
-    for (auto& ball : balls) {
-        const glm::vec4 uvRect(0.0f, 0.0f, 1.0f, 1.0f);
-        const glm::vec4 destRect(ball.position.x - ball.radius, ball.position.y - ball.radius,
-                                 ball.radius * 2.0f, ball.radius * 2.0f);
-        spriteBatch.draw(destRect, uvRect, ball.textureId, 0.0f, ball.color);
+    // Render all the balls, one drawMany per run of balls sharing a texture
+    size_t runStart = 0;
+    for (size_t i = 0; i <= balls.size(); i++) {
+        if (i < balls.size() && balls[i].textureId == balls[runStart].textureId) {
+            continue;
+        }
+        if (i > runStart) {
+            m_destRects.clear();
+            m_colors.clear();
+            for (size_t b = runStart; b < i; b++) {
+                const Ball& ball = balls[b];
+                m_destRects.emplace_back(ball.position.x - ball.radius, ball.position.y - ball.radius,
+                                         ball.radius * 2.0f, ball.radius * 2.0f);
+                m_colors.push_back(ball.color);
+            }
+            spriteBatch.drawMany(m_destRects.data(), nullptr, m_colors.data(), m_destRects.size(),
+                                 balls[runStart].textureId);
+        }
+        runStart = i;
     }
 
     spriteBatch.end();
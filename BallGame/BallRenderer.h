@@ -13,6 +13,8 @@ public:
                              const glm::mat4& projectionMatrix);
 protected:
     std::unique_ptr<ge::GLSLProgram> m_program = nullptr;
+    std::vector<glm::vec4> m_destRects; ///< kept between frames for drawMany
+    std::vector<ge::ColorRGBA8> m_colors;
 };
 
 // Visualizes kinetic energy
@@ -59,6 +59,9 @@ void MainGame::run() {
         draw();
         m_fps = m_fpsLimiter.endFrame();
     }
+
+    // while the GL context is still alive
+    m_spriteBatch.dispose();
 }
 
 void MainGame::init() {
@@ -73,7 +76,7 @@ void MainGame::init() {
     // Point the camera to the center of the screen
     m_camera.setPosition(glm::vec2(m_screenWidth / 2.0f, m_screenHeight / 2.0f));
     
-    m_spriteBatch.init();
+    m_spriteBatch.init(ge::VertexUpload::STREAMING);
     // Initialize sprite font
     m_spriteFont = std::make_unique<ge::SpriteFont>("Fonts/chintzy.ttf", 40);
 
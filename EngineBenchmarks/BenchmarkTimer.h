@@ -0,0 +1,19 @@
+#pragma once
+#include <chrono>
+
+/// Wall clock time since construction or the last restart()
+class BenchmarkTimer
+{
+public:
+	BenchmarkTimer() : m_start(std::chrono::high_resolution_clock::now()) {}
+
+	void restart() { m_start = std::chrono::high_resolution_clock::now(); }
+
+	double elapsedMs() const
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - m_start).count();
+	}
+
+private:
+	std::chrono::high_resolution_clock::time_point m_start;
+};
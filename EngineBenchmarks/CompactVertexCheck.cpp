@@ -0,0 +1,74 @@
+#include "CompactVertexCheck.h"
+#include <GameEngineOpenGL\SpriteBatch.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+namespace {
+
+	/// what COMPACT_VERT_SRC computes from the attributes
+	void decode(const ge::CompactVertex& vertex, const glm::vec2& origin, glm::vec2& pos, glm::vec2& uv)
+	{
+		const float steps = (float)ge::CompactVertex::POSITION_SUBSTEPS;
+		pos = origin + glm::vec2(vertex.x / steps, vertex.y / steps);
+		uv = glm::vec2(vertex.u / 65535.f, vertex.v / 65535.f);
+	}
+
+	ge::Vertex makeVertex(float x, float y, float u, float v)
+	{
+		ge::Vertex vertex;
+		vertex.setPos(x, y);
+		vertex.setUV(u, v);
+		vertex.setColor(12, 34, 56, 78);
+		return vertex;
+	}
+}
+
+bool runCompactVertexCheck()
+{
+	const float steps = (float)ge::CompactVertex::POSITION_SUBSTEPS;
+	// the largest offset that still fits a GLshort
+	const float reach = 32767.f / steps;
+	const glm::vec2 origin(-1500.f, 250.f);
+
+	std::mt19937 rng(4321);
+	std::uniform_real_distribution<float> offsetDist(-reach, reach);
+	std::uniform_real_distribution<float> uvDist(0.f, 1.f);
+
+	float maxPosError = 0.f;
+	float maxUVError = 0.f;
+	bool colorsKept = true;
+
+	for (int i = 0; i < 1000000; i++) {
+		const ge::Vertex vertex = makeVertex(origin.x + offsetDist(rng), origin.y + offsetDist(rng), uvDist(rng), uvDist(rng));
+
+		ge::CompactVertex compact;
+		ge::SpriteBatch::encodeCompactVertex(vertex, origin, compact);
+
+		glm::vec2 pos, uv;
+		decode(compact, origin, pos, uv);
+
+		maxPosError = std::max(maxPosError, std::max(std::abs(pos.x - vertex.pos.x), std::abs(pos.y - vertex.pos.y)));
+		maxUVError = std::max(maxUVError, std::max(std::abs(uv.x - vertex.uv.u), std::abs(uv.y - vertex.uv.v)));
+		colorsKept &= compact.color.r == 12 && compact.color.g == 34 && compact.color.b == 56 && compact.color.a == 78;
+	}
+
+	// float rounding of the inputs themselves, the positions reach a few thousand units
+	const float posLimit = 0.5f / steps + 0.001f;
+	const float uvLimit = 0.5f / 65535.f + 1e-7f;
+
+	// past the reach and outside [0, 1] everything is clamped
+	ge::CompactVertex far;
+	ge::SpriteBatch::encodeCompactVertex(makeVertex(origin.x + 10000.f, origin.y - 10000.f, 1.5f, -0.5f), origin, far);
+	const bool clamped = far.x == 32767 && far.y == -32768 && far.u == 65535 && far.v == 0;
+
+	const bool passed = maxPosError <= posLimit && maxUVError <= uvLimit && colorsKept && clamped;
+
+	std::cout << "CompactVertex precision" << std::endl;
+	std::cout << "  max position error " << maxPosError << " (limit " << posLimit << ")" << std::endl;
+	std::cout << "  max uv error " << maxUVError << " (limit " << uvLimit << ")" << std::endl;
+	std::cout << "  colors kept " << (colorsKept ? "yes" : "NO") << ", far vertices clamped " << (clamped ? "yes" : "NO") << std::endl;
+
+	return passed;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+/// <summary>
+/// Checks the precision limits documented on ge::CompactVertex: positions within 4096 units
+/// of the origin come back within half a 1/8 step, further ones are clamped, UVs come back
+/// within half a 1/65535 step and are clamped to [0, 1]. Colors are kept as they are.
+/// </summary>
+/// <returns>false if any vertex is off by more than that</returns>
+bool runCompactVertexCheck();
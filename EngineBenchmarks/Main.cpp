@@ -0,0 +1,16 @@
+#include <iostream>
+#include "SortBenchmark.h"
+#include "CompactVertexCheck.h"
+#include "ParticleBenchmark.h"
+
+// Checks and timings of engine code that needs no window, run it in Release for the timings
+int main(int argc, char** argv) {
+	bool passed = true;
+
+	passed &= runSortBenchmark();
+	passed &= runCompactVertexCheck();
+	runParticleBenchmark();
+
+	std::cout << (passed ? "All checks passed" : "Some checks FAILED") << std::endl;
+	return passed ? 0 : 1;
+}
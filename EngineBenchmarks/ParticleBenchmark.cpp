@@ -0,0 +1,73 @@
+#include "ParticleBenchmark.h"
+#include "BenchmarkTimer.h"
+#include <GameEngineOpenGL\ParticleBatch2D.h>
+#include <GameEngineOpenGL\ParticleBatch2DT.h>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+	const int NUM_PARTICLES = 1000000;
+	const int NUM_UPDATES = 20;
+	const float DELTA_TIME = 1.f / 60.f;
+	// slow enough that no particle dies during the updates
+	const float DECAY_RATE = 0.01f;
+	const glm::vec2 GRAVITY(0.f, -200.f);
+
+	typedef ge::ParticleBatch2DT<ge::ParticlePolicies<ge::GravityPolicy, ge::MovePolicy, ge::FadePolicy>> PolicyBatch;
+
+	void gravityMoveFade(ge::Particle2D& p, float deltaTime)
+	{
+		p.velocity += GRAVITY * deltaTime;
+		p.pos += p.velocity * deltaTime;
+		p.color.a = ge::FadePolicy::lifeToByte(p.life, 0.f, 255.f);
+	}
+
+	void spawn(ge::IParticleBatch2D& batch)
+	{
+		for (int i = 0; i < NUM_PARTICLES; i++) {
+			const float angle = i * 0.001f;
+			batch.addParticle(glm::vec2(i % 1000, i / 1000), glm::vec2(std::cos(angle), std::sin(angle)) * 50.f,
+				ge::ColorRGBA8(255, 0, 0, 255), 4.f);
+		}
+	}
+
+	/// milliseconds per update
+	double timeUpdates(ge::IParticleBatch2D& batch)
+	{
+		// the first update pays for the page faults of the spawned arrays
+		batch.update(DELTA_TIME);
+
+		BenchmarkTimer timer;
+		for (int u = 0; u < NUM_UPDATES; u++) {
+			batch.update(DELTA_TIME);
+		}
+		return timer.elapsedMs() / NUM_UPDATES;
+	}
+}
+
+void runParticleBenchmark()
+{
+	const ge::GLTexture texture = {};
+
+	ge::ParticleBatch2D functionBatch;
+	functionBatch.init(NUM_PARTICLES, DECAY_RATE, texture, gravityMoveFade);
+	spawn(functionBatch);
+
+	PolicyBatch policyBatch;
+	policyBatch.init(NUM_PARTICLES, DECAY_RATE, texture, { ge::GravityPolicy(GRAVITY), ge::MovePolicy(), ge::FadePolicy() });
+	spawn(policyBatch);
+
+	ge::ParticleBatch2D kernelBatch;
+	kernelBatch.init(NUM_PARTICLES, DECAY_RATE, texture, ge::ParticleIntegration::MOVE_AND_FADE);
+	spawn(kernelBatch);
+
+	const double functionMs = timeUpdates(functionBatch);
+	const double policyMs = timeUpdates(policyBatch);
+	const double kernelMs = timeUpdates(kernelBatch);
+
+	std::cout << "Particle update, " << NUM_PARTICLES << " live particles" << std::endl;
+	std::cout << "  std::function per particle: " << functionMs << " ms" << std::endl;
+	std::cout << "  ParticleBatch2DT policies: " << policyMs << " ms" << std::endl;
+	std::cout << "  MOVE_AND_FADE kernel, no gravity: " << kernelMs << " ms" << std::endl;
+}
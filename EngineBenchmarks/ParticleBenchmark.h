@@ -0,0 +1,8 @@
+#pragma once
+
+/// <summary>
+/// Times one update of a million live particles doing gravity, move and fade, through the
+/// per particle std::function of ParticleBatch2D, through ParticleBatch2DT policies, and, without
+/// the gravity, through the ParticleIntegration::MOVE_AND_FADE kernel
+/// </summary>
+void runParticleBenchmark();
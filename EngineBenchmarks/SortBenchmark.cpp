@@ -0,0 +1,130 @@
+#include "SortBenchmark.h"
+#include "BenchmarkTimer.h"
+#include <GameEngineOpenGL\RadixSort.h>
+#include <GameEngineOpenGL\SpriteBatch.h>
+#include <GameEngineOpenGL\SpriteSortKeys.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+	/// what SpriteBatch stored per sprite before the sort keys, and sorted through pointers
+	struct Glyph {
+		GLuint texture;
+		float depth;
+		ge::Vertex topLeft, bottomLeft, topRight, bottomRight;
+	};
+
+	void stableSortGlyphs(ge::GlyphSortType sortType, std::vector<Glyph*>& glyphPtrs)
+	{
+		switch (sortType) {
+		case ge::GlyphSortType::FRONT_TO_BACK:
+			std::stable_sort(glyphPtrs.begin(), glyphPtrs.end(),
+				[](Glyph* a, Glyph* b) {return a->depth < b->depth; });
+			break;
+		case ge::GlyphSortType::BACK_TO_FRONT:
+			std::stable_sort(glyphPtrs.begin(), glyphPtrs.end(),
+				[](Glyph* a, Glyph* b) {return a->depth > b->depth; });
+			break;
+		case ge::GlyphSortType::TEXTURE:
+			std::stable_sort(glyphPtrs.begin(), glyphPtrs.end(),
+				[](Glyph* a, Glyph* b) {return a->texture < b->texture; });
+			break;
+		default:
+			break;
+		}
+	}
+
+	/// depths a few ulps apart around a handful of values, negative ones and many ties included
+	std::vector<Glyph> makeGlyphs(size_t count, std::mt19937& rng)
+	{
+		const float bases[] = { -100.f, -1.f, 0.f, 0.5f, 1.f, 1000.f };
+		std::uniform_int_distribution<int> baseDist(0, 5);
+		std::uniform_int_distribution<int> ulpDist(0, 4);
+		std::uniform_int_distribution<int> textureDist(0, 15);
+
+		std::vector<Glyph> glyphs(count);
+		for (auto& glyph : glyphs) {
+			float depth = bases[baseDist(rng)];
+			for (int ulps = ulpDist(rng); ulps > 0; ulps--) {
+				depth = std::nextafter(depth, 1e30f);
+			}
+			glyph.depth = depth;
+			// names far apart, like those of a driver handing out sparse ids
+			glyph.texture = 1 + (GLuint)textureDist(rng) * 70000;
+		}
+		return glyphs;
+	}
+
+	const char* sortTypeName(ge::GlyphSortType sortType)
+	{
+		switch (sortType) {
+		case ge::GlyphSortType::FRONT_TO_BACK: return "FRONT_TO_BACK";
+		case ge::GlyphSortType::BACK_TO_FRONT: return "BACK_TO_FRONT";
+		case ge::GlyphSortType::TEXTURE: return "TEXTURE";
+		default: return "NONE";
+		}
+	}
+}
+
+bool runSortBenchmark()
+{
+	const ge::GlyphSortType sortTypes[] = {
+		ge::GlyphSortType::FRONT_TO_BACK, ge::GlyphSortType::BACK_TO_FRONT, ge::GlyphSortType::TEXTURE };
+	const size_t counts[] = { 1000, 10000, 100000 };
+
+	std::mt19937 rng(1234);
+	bool passed = true;
+
+	std::cout << "SpriteBatch sort, radix sorted keys against std::stable_sort of glyph pointers" << std::endl;
+
+	for (ge::GlyphSortType sortType : sortTypes) {
+		for (size_t count : counts) {
+			std::vector<Glyph> glyphs = makeGlyphs(count, rng);
+
+			std::vector<Glyph*> glyphPtrs(count);
+			std::vector<uint64_t> keys(count);
+			std::vector<uint64_t> scratch;
+			ge::SpriteSortKeys keyBuilder;
+
+			// the same number of sorted glyphs for every count
+			const size_t repeats = std::max((size_t)1, (size_t)2000000 / count);
+
+			BenchmarkTimer timer;
+			for (size_t r = 0; r < repeats; r++) {
+				for (size_t i = 0; i < count; i++) {
+					glyphPtrs[i] = &glyphs[i];
+				}
+				stableSortGlyphs(sortType, glyphPtrs);
+			}
+			const double stableMs = timer.elapsedMs() / repeats;
+
+			timer.restart();
+			for (size_t r = 0; r < repeats; r++) {
+				// the key path of SpriteBatch, with every sprite in the same render state
+				keyBuilder.begin(sortType);
+				for (size_t i = 0; i < count; i++) {
+					keys[i] = keyBuilder.makeKey(glyphs[i].texture, 0, glyphs[i].depth, (uint32_t)i);
+				}
+				keyBuilder.rankTextures(keys);
+				ge::radixSort(keys, scratch, 4);
+			}
+			const double radixMs = timer.elapsedMs() / repeats;
+
+			bool sameOrder = true;
+			for (size_t i = 0; i < count && sameOrder; i++) {
+				sameOrder = &glyphs[(uint32_t)keys[i]] == glyphPtrs[i];
+			}
+			passed &= sameOrder;
+
+			std::cout << "  " << sortTypeName(sortType) << " " << count << " glyphs: stable_sort "
+				<< stableMs << " ms, radix " << radixMs << " ms"
+				<< (sameOrder ? "" : "  ORDER DIFFERS") << std::endl;
+		}
+	}
+
+	return passed;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+/// <summary>
+/// Checks that the radix sorted SpriteSortKeys of SpriteBatch give the same order as the
+/// std::stable_sort of glyph pointers it replaced, for FRONT_TO_BACK, BACK_TO_FRONT and TEXTURE, depths one ulp
+/// apart and ties included. Then times both at 1k, 10k and 100k glyphs.
+/// </summary>
+/// <returns>false if any order differs</returns>
+bool runSortBenchmark();
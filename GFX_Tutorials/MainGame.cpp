@@ -28,6 +28,8 @@ void BallGameMainGame::run()
 	initSystems();
 
 	gameLoop();
+
+	spriteBatch.dispose();
 }
 
 /// <summary>
@@ -55,6 +55,14 @@ namespace ge {
 		return screenCoords;
 	}
 
+	glm::vec4 Camera2D::getViewRect() const
+	{
+		auto scaledScrDims = glm::vec2(m_scrW, m_scrH) / m_scale;
+
+		// camera position is centered
+		return glm::vec4(m_pos - scaledScrDims / 2.f, scaledScrDims);
+	}
+
 	// AABB test to see if object is inside the view
 	bool Camera2D::isInView(glm::vec2& Pos, const glm::vec2& Dim)
 	{
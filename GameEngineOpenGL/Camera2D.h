@@ -13,6 +13,8 @@ namespace ge {
 		void update();
 		glm::vec2 covertScreenToWorld(glm::vec2 screenCoords);
 		bool isInView(glm::vec2& Pos, const glm::vec2& Dim);
+		/// visible world area as x, y, width, height
+		glm::vec4 getViewRect() const;
 		void offsetPosition(const glm::vec2& offset) { m_pos += offset; m_needsMatrixUpdate = true; }
 		void offsetScale(float offset) { m_scale += offset; if (m_scale < 0.001f) m_scale = 0.001f; m_needsMatrixUpdate = true; }
 		// setters
@@ -3,6 +3,8 @@
 #include <SDL\SDL.h>
 #include "DebugRenderer.h"
 #include "ErrManager.h"
+#include "QuadTransform.h"
+#include "RenderStats.h"
 
 
 namespace ge
@@ -120,6 +122,7 @@ namespace ge
 		GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0)); // unbind
 
 		m_numElements = m_indices.size();
+		RenderStats::current().bytesUploaded += m_verts.size() * sizeof(DebugVertex) + m_indices.size() * sizeof(GLuint);
 		m_indices.clear();
 		m_verts.clear();
 	}
@@ -139,6 +142,9 @@ namespace ge
 		GLCall(glDrawElements(GL_LINES, m_numElements, GL_UNSIGNED_INT, 0));
 		GLCall(glBindVertexArray(0));
 
+		RenderStats::current().drawCalls++;
+		RenderStats::current().debugElements += m_numElements;
+
 		m_program.unuse();
 	}
 
@@ -168,33 +174,19 @@ namespace ge
 		m_program.dispose();
 	}
 
-	glm::vec2 rotatePoint(const glm::vec2& pos, float angle) {
-		glm::vec2 newVec;
-		newVec.x = pos.x * cos(angle) - pos.y * sin(angle);
-		newVec.y = pos.x * sin(angle) + pos.y * cos(angle);
-		return newVec;
-	}
-
 	void DebugRenderer::drawBox(const glm::vec4 & destRect, const ColorRGBA8 & color, float angle)
 	{
 		int i = m_verts.size();
 		m_verts.resize(i + 4);
 
-		glm::vec2 halfDims(destRect.z / 2.0f, destRect.w / 2.0f);
+		// Rotate the points, same kernel as the sprite batch
+		glm::vec2 rotation = rotationFromAngle(angle);
+		glm::vec2 corners[4];
+		transformQuads(&destRect, &rotation, 1, corners);
 
-		// Get points centered at origin
-		glm::vec2 tl(-halfDims.x, halfDims.y);
-		glm::vec2 bl(-halfDims.x, -halfDims.y);
-		glm::vec2 br(halfDims.x, -halfDims.y);
-		glm::vec2 tr(halfDims.x, halfDims.y);
-
-		glm::vec2 offsetPos(destRect.x, destRect.y);
-
-		// Rotate the points
-		m_verts[i].pos = rotatePoint(tl, angle) + halfDims + offsetPos;
-		m_verts[i + 1].pos = rotatePoint(bl, angle) + halfDims + offsetPos;
-		m_verts[i + 2].pos = rotatePoint(br, angle) + halfDims + offsetPos;
-		m_verts[i + 3].pos = rotatePoint(tr, angle) + halfDims + offsetPos;
+		for (int j = 0; j < 4; j++) {
+			m_verts[i + j].pos = corners[j];
+		}
 
 		// adding the color
 		for (int j = i; j < i + 4; j++) {
@@ -0,0 +1,39 @@
+#include "DoubleBufferedSpriteBatch.h"
+
+namespace ge {
+
+	void DoubleBufferedSpriteBatch::init(VertexUpload upload /* = VertexUpload::ORPHAN */, VertexFormat format /* = VertexFormat::STANDARD */)
+	{
+		m_batches[0].init(upload, format, BatchProcessing::WORKER_THREAD);
+		m_batches[1].init(upload, format, BatchProcessing::WORKER_THREAD);
+	}
+
+	void DoubleBufferedSpriteBatch::dispose()
+	{
+		m_batches[0].dispose();
+		m_batches[1].dispose();
+		m_front = 0;
+		m_ended = -1;
+	}
+
+	SpriteBatch & DoubleBufferedSpriteBatch::begin(GlyphSortType sortBy /* = GlyphSortType::TEXTURE */, const Camera2D * cullCamera /* = nullptr */)
+	{
+		// the front batch was ended two frames ago, its worker is long done
+		m_batches[m_front].begin(sortBy, cullCamera);
+		return m_batches[m_front];
+	}
+
+	void DoubleBufferedSpriteBatch::end()
+	{
+		m_batches[m_front].end();
+		m_ended = m_front;
+		m_front ^= 1;
+	}
+
+	void DoubleBufferedSpriteBatch::renderBatch()
+	{
+		if (m_ended < 0) { return; }
+		m_batches[m_ended].renderBatch();
+	}
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "SpriteBatch.h"
+
+namespace ge {
+
+	class Camera2D;
+
+	/// <summary>
+	/// Two SpriteBatches with BatchProcessing::WORKER_THREAD used in turns. end() hands the frame to a
+	/// worker thread that sorts it and writes its vertices, and the next frame can be drawn into the
+	/// other batch meanwhile. renderBatch() renders the last ended frame, waiting for its worker and uploading it.
+	/// Calling renderBatch() before the next begin() hides the sprite work behind whatever runs in between,
+	/// e.g. update, renderBatch, begin, draw, end gives the worker the whole update of the next frame.
+	/// </summary>
+	class DoubleBufferedSpriteBatch
+	{
+	public:
+		void init(VertexUpload upload = VertexUpload::ORPHAN, VertexFormat format = VertexFormat::STANDARD);
+		/// frees both batches, waiting for their workers
+		void dispose();
+
+		/// <summary>
+		/// starts a new frame, draw into the returned batch until end()
+		/// </summary>
+		SpriteBatch& begin(GlyphSortType sortBy = GlyphSortType::TEXTURE, const Camera2D* cullCamera = nullptr);
+		void end();
+
+		/// <summary>
+		/// renders the last frame given to end(), if there is one
+		/// </summary>
+		void renderBatch();
+
+	private:
+		SpriteBatch m_batches[2];
+		int m_front = 0; ///< batch being drawn into
+		int m_ended = -1; ///< batch of the last ended frame
+	};
+
+}
@@ -39,6 +39,8 @@ namespace ge {
 
 		void dispose();
 
+		GLuint getProgramID() const { return m_programID; }
+
 	private:
 		int m_numAttributes;
 
@@ -1,10 +1,27 @@
 #pragma once
 #include <GL\glew.h>
+#include <glm\glm.hpp>
 
 namespace ge {
 	struct GLTexture
 	{
 		GLuint id;
 		int w, h;
+		/// GL_TEXTURE_2D, or GL_TEXTURE_2D_ARRAY for layered textures
+		GLenum target = GL_TEXTURE_2D;
+		/// layer of a GL_TEXTURE_2D_ARRAY, 0 for plain GL_TEXTURE_2D
+		GLuint layer = 0;
+		/// <summary>
+		/// Where the image lies in the GL texture, (0,0,1,1) unless it was packed in an atlas page.
+		/// In the same flipped v space the shaders sample with, so it maps draw() UVs directly.
+		/// </summary>
+		glm::vec4 uvRect = glm::vec4(0.f, 0.f, 1.f, 1.f);
+
+		/// maps a uv rect of the image to the uv rect of the GL texture
+		glm::vec4 subUV(const glm::vec4& uv) const
+		{
+			return glm::vec4(uvRect.x + uv.x * uvRect.z, uvRect.y + uv.y * uvRect.w,
+				uv.z * uvRect.z, uv.w * uvRect.w);
+		}
 	};
 }
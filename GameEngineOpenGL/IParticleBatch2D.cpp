@@ -0,0 +1,188 @@
+#include "IParticleBatch2D.h"
+#include "RadixSort.h"
+
+
+namespace ge {
+
+	IParticleBatch2D::IParticleBatch2D()
+	{ /*empty*/ }
+
+
+	IParticleBatch2D::~IParticleBatch2D()
+	{ /*empty*/ }
+
+	void ParticleSpawnQueue::addParticle(const glm::vec2 & pos,
+		const glm::vec2 & velocity,
+		const ColorRGBA8 & color, float size)
+	{
+		Spawn spawn;
+		spawn.pos = pos;
+		spawn.velocity = velocity;
+		spawn.color = color;
+		spawn.size = size;
+		m_spawns.push_back(spawn);
+	}
+
+	void IParticleBatch2D::update(float deltaTime)
+	{
+		mergeSpawnQueues();
+		simulate(getLiveParticles(), deltaTime);
+		removeDeadParticles();
+	}
+
+	void IParticleBatch2D::mergeSpawnQueues()
+	{
+		for (auto& queue : m_spawnQueues) {
+			for (const auto& spawn : queue.m_spawns) {
+				addParticle(spawn.pos, spawn.velocity, spawn.color, spawn.size);
+			}
+			queue.m_spawns.clear();
+		}
+	}
+
+	void IParticleBatch2D::allocate(int maxParticles, float decayRate, const GLTexture & texture)
+	{
+		m_decayRate = decayRate;
+		m_texture = texture;
+
+		m_numParticles = 0;
+		m_numDropped = 0;
+		m_numOverwritten = 0;
+		m_oldestOrder.clear();
+		m_nextOldest = 0;
+
+		resize(maxParticles);
+	}
+
+	void IParticleBatch2D::resize(int maxParticles)
+	{
+		m_maxParticles = maxParticles;
+
+		m_posX.resize(m_maxParticles);
+		m_posY.resize(m_maxParticles);
+		m_velX.resize(m_maxParticles);
+		m_velY.resize(m_maxParticles);
+		m_life.resize(m_maxParticles);
+		m_width.resize(m_maxParticles);
+		m_colors.resize(m_maxParticles);
+
+		m_arrays.posX = m_posX.data();
+		m_arrays.posY = m_posY.data();
+		m_arrays.velX = m_velX.data();
+		m_arrays.velY = m_velY.data();
+		m_arrays.life = m_life.data();
+		m_arrays.width = m_width.data();
+		m_arrays.color = m_colors.data();
+	}
+
+	const ParticleArrays & IParticleBatch2D::getLiveParticles()
+	{
+		m_arrays.count = m_numParticles;
+		return m_arrays;
+	}
+
+	void IParticleBatch2D::removeDeadParticles()
+	{
+		int i = 0;
+		while (i < m_numParticles) {
+			if (m_life[i] > 0.f) {
+				i++;
+				continue;
+			}
+			// the last one takes its place and gets checked next
+			m_numParticles--;
+			if (i != m_numParticles) {
+				moveParticle(m_numParticles, i);
+			}
+		}
+
+		// the lives changed
+		m_oldestOrder.clear();
+		m_nextOldest = 0;
+	}
+
+	void IParticleBatch2D::moveParticle(int from, int to)
+	{
+		m_posX[to] = m_posX[from];
+		m_posY[to] = m_posY[from];
+		m_velX[to] = m_velX[from];
+		m_velY[to] = m_velY[from];
+		m_life[to] = m_life[from];
+		m_width[to] = m_width[from];
+		m_colors[to] = m_colors[from];
+	}
+
+	void IParticleBatch2D::draw(SpriteBatch* spriteBatch)
+	{
+		glm::vec4 uvRect = m_texture.subUV(glm::vec4(0.f, 0.f, 1.f, 1.f));
+
+		// only live particles are in range
+		m_drawBuffer.resize(m_numParticles);
+		for (int i = 0; i < m_numParticles; i++) {
+			SpriteInstance& sprite = m_drawBuffer[i];
+			sprite.destRect = glm::vec4(m_posX[i], m_posY[i], m_width[i], m_width[i]);
+			sprite.uvRect = uvRect;
+			sprite.color = m_colors[i];
+			sprite.rotation = glm::vec2(1.f, 0.f);
+		}
+
+		// all of them in one call
+		spriteBatch->drawMany(m_drawBuffer.data(), m_drawBuffer.size(), m_texture.id);
+	}
+	void IParticleBatch2D::addParticle(const glm::vec2 & pos,
+		const glm::vec2 & velocity,
+		const ColorRGBA8 & color, float size)
+	{
+		int particleIdx = allocParticle();
+		if (particleIdx < 0) { return; }
+
+		m_life[particleIdx] = 1.0f;
+		m_posX[particleIdx] = pos.x;
+		m_posY[particleIdx] = pos.y;
+		m_velX[particleIdx] = velocity.x;
+		m_velY[particleIdx] = velocity.y;
+		m_colors[particleIdx] = color;
+		m_width[particleIdx] = size;
+	}
+
+	int IParticleBatch2D::allocParticle()
+	{
+		if (m_numParticles < m_maxParticles) {
+			return m_numParticles++;
+		}
+
+		switch (m_overflow) {
+		case ParticleOverflow::GROW:
+			resize(m_maxParticles > 0 ? m_maxParticles * 2 : 1);
+			return m_numParticles++;
+		case ParticleOverflow::OVERWRITE_OLDEST:
+			if (m_numParticles > 0) {
+				m_numOverwritten++;
+				return findOldestParticle();
+			}
+			break;
+		default:
+			break;
+		}
+
+		m_numDropped++;
+		return -1;
+	}
+
+	int IParticleBatch2D::findOldestParticle()
+	{
+		// one sort for all the overwrites until the next update, the overwritten ones become the
+		// newest so the rest of the order holds
+		if (m_nextOldest == m_oldestOrder.size()) {
+			m_oldestOrder.resize(m_numParticles);
+			for (int i = 0; i < m_numParticles; i++) {
+				m_oldestOrder[i] = ((uint64_t)floatToSortable(m_life[i]) << 32) | (uint32_t)i;
+			}
+			// the indices are already ascending
+			radixSort(m_oldestOrder, m_sortScratch, 4);
+			m_nextOldest = 0;
+		}
+
+		return (int)(uint32_t)m_oldestOrder[m_nextOldest++];
+	}
+}
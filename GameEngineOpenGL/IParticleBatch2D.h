@@ -0,0 +1,144 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm\glm.hpp>
+#include "Vertex.h"
+#include "SpriteBatch.h"
+#include "GLTexture.h"
+#include "ParticleIntegrator.h"
+
+namespace ge {
+
+	/// What IParticleBatch2D::addParticle does when all its particles are alive
+	enum class ParticleOverflow {
+		DROP,				///< the new particle is dropped and counted, see getNumDropped
+		OVERWRITE_OLDEST,	///< replaces the live particle with the least life left
+		GROW				///< the arrays double in size
+	};
+
+	/// <summary>
+	/// Particles added from a thread other than the one updating the batch, see IParticleBatch2D::getSpawnQueue
+	/// </summary>
+	class ParticleSpawnQueue
+	{
+	public:
+		void addParticle(const glm::vec2& pos, const glm::vec2& velocity,
+			const ColorRGBA8& color, float size);
+
+		size_t getNumParticles() const { return m_spawns.size(); }
+
+	private:
+		friend class IParticleBatch2D;
+
+		struct Spawn {
+			glm::vec2 pos;
+			glm::vec2 velocity;
+			ColorRGBA8 color;
+			float size;
+		};
+		std::vector<Spawn> m_spawns;
+	};
+
+	class ParticleEngine2D;
+	class ParticleRenderer2D;
+
+	/// <summary>
+	/// Storage, spawning and drawing shared by ParticleBatch2D and ParticleBatch2DT, update() is up to them.
+	/// Up to maxParticles particles stored as one array per attribute. The live particles are kept at the
+	/// front of the arrays, dead ones are swapped with the last live one, so update and draw cost grows
+	/// with the live particles and adding one is O(1)
+	/// </summary>
+	class IParticleBatch2D
+	{
+	public:
+		IParticleBatch2D();
+		virtual ~IParticleBatch2D();
+
+		/// <summary>
+		/// adds the particles of the spawn queues, then moves the live particles and decays their life.
+		/// ParticleEngine2D can split it over a ThreadPool instead
+		/// </summary>
+		void update(float deltaTime);
+
+		/// adds the live particles to a begun sprite batch, ParticleRenderer2D draws them without one
+		void draw(SpriteBatch* spriteBatch);
+
+		void addParticle(const glm::vec2& pos, const glm::vec2& velocity,
+			const ColorRGBA8& color, float size);
+
+		/// what happens to particles added while all are alive, OVERWRITE_OLDEST by default
+		void setOverflow(ParticleOverflow overflow) { m_overflow = overflow; }
+
+		/// <summary>
+		/// queues for adding particles from other threads, one per thread. Their particles are added at the start
+		/// of the next update, in queue index order, so the result doesn't depend on the thread timing.
+		/// Set the count while no thread uses the queues, and fill them only while no update runs
+		/// </summary>
+		void setNumSpawnQueues(size_t count) { m_spawnQueues.resize(count); }
+		ParticleSpawnQueue& getSpawnQueue(size_t index) { return m_spawnQueues[index]; }
+
+		// getters
+		int getNumParticles() const { return m_numParticles; } ///< alive
+		int getMaxParticles() const { return m_maxParticles; }
+		const GLTexture& getTexture() const { return m_texture; }
+		size_t getNumDropped() const { return m_numDropped; } ///< by ParticleOverflow::DROP since init
+		size_t getNumOverwritten() const { return m_numOverwritten; } ///< by ParticleOverflow::OVERWRITE_OLDEST since init
+
+	protected:
+		/// <summary>
+		/// moves particles and decays their life, a ParticleEngine2D with a ThreadPool calls it on
+		/// chunks of the live particles from several threads at once
+		/// </summary>
+		virtual void simulate(const ParticleArrays& particles, float deltaTime) = 0;
+
+		/// sizes the arrays, no particle is alive
+		void allocate(int maxParticles, float decayRate, const GLTexture& texture);
+
+		float m_decayRate = 0.1f;
+
+	private:
+		friend class ParticleEngine2D;
+		friend class ParticleRenderer2D;
+
+		/// adds the queued particles and empties the queues
+		void mergeSpawnQueues();
+		/// the live particles, for simulate()
+		const ParticleArrays& getLiveParticles();
+		/// swaps the dead particles out of the live range, update() ends with it
+		void removeDeadParticles();
+		/// slot for a new particle, -1 if it gets dropped
+		int allocParticle();
+		/// live particle with the least life left, for ParticleOverflow::OVERWRITE_OLDEST
+		int findOldestParticle();
+		/// resizes the arrays keeping the live particles
+		void resize(int maxParticles);
+		void moveParticle(int from, int to);
+
+		int m_maxParticles = 0;
+		int m_numParticles = 0; ///< the live ones are [0, m_numParticles)
+		GLTexture m_texture;
+
+		ParticleOverflow m_overflow = ParticleOverflow::OVERWRITE_OLDEST;
+		size_t m_numDropped = 0;
+		size_t m_numOverwritten = 0;
+		// live particles by life left, built on the first overwrite after an update, (life << 32) | index
+		std::vector<uint64_t> m_oldestOrder;
+		std::vector<uint64_t> m_sortScratch;
+		size_t m_nextOldest = 0;
+
+		// one entry per particle in every array
+		std::vector<float> m_posX;
+		std::vector<float> m_posY;
+		std::vector<float> m_velX;
+		std::vector<float> m_velY;
+		std::vector<float> m_life;
+		std::vector<float> m_width;
+		std::vector<ColorRGBA8> m_colors;
+		ParticleArrays m_arrays; ///< points into the vectors above, count is the live particles
+
+		std::vector<ParticleSpawnQueue> m_spawnQueues;
+
+		std::vector<SpriteInstance> m_drawBuffer; ///< live particles handed to SpriteBatch::drawMany
+	};
+}
@@ -8,20 +8,10 @@ namespace ge {
 	{
 		GLTexture m_texture = {};
 
-		// file buffers
 		std::vector<unsigned char> out;
-		std::vector <unsigned char> in;
-
 		unsigned long w, h;
 
-		if (false == IOManager::readFileToBuffer(filePath, in)) {
-			fatalError("ImageLoader: Failed to load PNG file to buffer!");
-		}
-
-		int errCode = decodePNG(out, w, h, &(in[0]), in.size());
-		if (errCode) {
-			fatalError("ImageLoader: Decode PNG failed with error: " + std::to_string(errCode));
-		}
+		decodePNGFile(filePath, out, w, h);
 
 		// generating OpenGL texture object
 		GLCall(glGenTextures(1, &(m_texture.id)));
@@ -50,4 +40,19 @@ namespace ge {
 
 		return m_texture;
 	}
+
+	void ImageLoader::decodePNGFile(const std::string& filePath, std::vector<unsigned char>& out, unsigned long& w, unsigned long& h)
+	{
+		// file buffer
+		std::vector <unsigned char> in;
+
+		if (false == IOManager::readFileToBuffer(filePath, in)) {
+			fatalError("ImageLoader: Failed to load PNG file to buffer!");
+		}
+
+		int errCode = decodePNG(out, w, h, &(in[0]), in.size());
+		if (errCode) {
+			fatalError("ImageLoader: Decode PNG failed with error: " + std::to_string(errCode));
+		}
+	}
 }
\ No newline at end of file
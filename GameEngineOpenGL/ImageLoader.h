@@ -3,6 +3,7 @@
 #include "PicoPNG.h"
 
 #include <string>
+#include <vector>
 
 namespace ge {
 	class ImageLoader
@@ -10,6 +11,9 @@ namespace ge {
 	public:
 		static GLTexture loadPNG(std::string filePath);
 
+		/// decodes a PNG file to RGBA pixels, without creating a texture
+		static void decodePNGFile(const std::string& filePath, std::vector<unsigned char>& out, unsigned long& w, unsigned long& h);
+
 	};
 }
 
@@ -1,92 +1,90 @@
 #include "ParticleBatch2D.h"
+#include "ParticlePolicies.h"
 
 
 namespace ge {
 
+	namespace {
+
+		/// the per particle std::function as a policy, it gets a Particle2D copy of particle i
+		struct FunctionPolicy {
+			const std::function<void(Particle2D&, float)>* func;
+
+			void apply(const ParticleArrays& a, size_t i, float deltaTime) const
+			{
+				Particle2D p;
+				p.pos = glm::vec2(a.posX[i], a.posY[i]);
+				p.velocity = glm::vec2(a.velX[i], a.velY[i]);
+				p.color = a.color[i];
+				p.life = a.life[i];
+				p.width = a.width[i];
+
+				(*func)(p, deltaTime);
+
+				a.posX[i] = p.pos.x;
+				a.posY[i] = p.pos.y;
+				a.velX[i] = p.velocity.x;
+				a.velY[i] = p.velocity.y;
+				a.color[i] = p.color;
+				a.life[i] = p.life;
+				a.width[i] = p.width;
+			}
+		};
+	}
+
 	ParticleBatch2D::ParticleBatch2D()
 	{ /*empty*/ }
 
 
 	ParticleBatch2D::~ParticleBatch2D()
-	{
-		delete[] m_particles;
-	}
+	{ /*empty*/ }
 
 	void ParticleBatch2D::init(
-		int maxParticles, 
+		int maxParticles,
 		float decayRate,
-		GLTexture m_texture, 
+		GLTexture texture,
 		std::function<void(Particle2D&, float)> updateFunc/* = defaultParticleupdate */)
 	{
-		m_maxParticles = maxParticles;
-		m_decayRate = decayRate;
-		m_texture = m_texture;
 		m_updateFunc = updateFunc;
+		m_batchUpdateFunc = nullptr;
+		m_integration = ParticleIntegration::NONE;
 
-		m_particles = new Particle2D[m_maxParticles];
+		allocate(maxParticles, decayRate, texture);
 	}
 
-	void ParticleBatch2D::update(float deltaTime)
+	void ParticleBatch2D::init(
+		int maxParticles,
+		float decayRate,
+		GLTexture texture,
+		ParticleIntegration integration,
+		ParticleBatchUpdate batchUpdateFunc /* = nullptr */)
 	{
-		for (int i = 0; i < m_maxParticles; i++) {
-			
-			// if a particle is active, update it
-			if (m_particles[i].life > 0.f) {
-				m_updateFunc(m_particles[i], deltaTime);
-				m_particles[i].life -= m_decayRate * deltaTime;
-			}
-		}
+		m_updateFunc = nullptr;
+		m_batchUpdateFunc = batchUpdateFunc;
+		m_integration = integration;
 
+		allocate(maxParticles, decayRate, texture);
 	}
 
-	void ParticleBatch2D::draw(SpriteBatch* spriteBatch)
+	void ParticleBatch2D::simulate(const ParticleArrays& particles, float deltaTime)
 	{
-		glm::vec4 uvRect(0.f, 0.f, 1.f, 1.f);
-
-		for (int i = 0; i < m_maxParticles; i++) {
-			auto& p = m_particles[i];
-
-			// if a particle is active, draw it
-			if (p.life > 0.f) {
-				glm::vec4 destRect(p.pos.x, p.pos.y, p.width, p.width);
-
-				spriteBatch->draw(destRect, uvRect, m_texture.id, 0.f, p.color);
-			}
+		if (m_updateFunc) {
+			FunctionPolicy policy;
+			policy.func = &m_updateFunc;
+			updateParticles(particles, policy, deltaTime, m_decayRate);
 		}
-	}
-	void ParticleBatch2D::addParticle(const glm::vec2 & pos,
-		const glm::vec2 & velocity,
-		const ColorRGBA8 & color, float size)
-	{
-		int particleIdx = findFreeParticle();
-
-		auto&p = m_particles[particleIdx];
-		p.life = 1.0f;
-		p.pos = pos;
-		p.velocity = velocity;
-		p.color = color;
-		p.width = size;
-	}
-	int ParticleBatch2D::findFreeParticle()
-	{
-		// this loop should find a free particle
-		for (int i = m_freeParticleIdx; i < m_maxParticles; i++) {
-			if (m_particles[i].life <= 0.f) {
-				m_freeParticleIdx = i;
-				return i;
+		else {
+			if (m_batchUpdateFunc) {
+				m_batchUpdateFunc(particles, deltaTime);
 			}
-		}
 
-		// this loop is going to check the rest of the array for a free particle
-		for (int i = 0; i < m_freeParticleIdx; i++) {
-			if (m_particles[i].life <= 0.f) {
-				m_freeParticleIdx = i;
-				return i;
+			if (m_integration == ParticleIntegration::NONE) {
+				// no policy, just the life decay
+				updateParticles(particles, ParticlePolicies<>(), deltaTime, m_decayRate);
+			}
+			else {
+				integrateParticles(particles, deltaTime, m_decayRate, m_integration == ParticleIntegration::MOVE_AND_FADE);
 			}
 		}
-
-		// and finaly, if no particle is free,
-		// we need to overwrite the first particle
-		return 0;
 	}
-}
\ No newline at end of file
+}
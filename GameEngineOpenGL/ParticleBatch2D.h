@@ -3,11 +3,12 @@
 #include <functional>
 #include <glm\glm.hpp>
 #include "Vertex.h"
-#include "SpriteBatch.h"
 #include "GLTexture.h"
+#include "IParticleBatch2D.h"
 
 namespace ge {
 
+	/// One particle, as seen by a per particle update function
 	class Particle2D {
 	public:
 		Particle2D() {};
@@ -25,34 +26,51 @@ namespace ge {
 		p.pos += p.velocity * deltaTime;
 	}
 
-	class ParticleBatch2D
+	/// What ParticleBatch2D::update does to every particle on its own, life always decays
+	enum class ParticleIntegration {
+		NONE,			///< the batch update function moves the particles itself
+		MOVE,			///< pos += velocity * deltaTime
+		MOVE_AND_FADE	///< same, and the color alpha follows life, 255 at 1 and 0 at 0
+	};
+
+	/// custom behavior over many live particles of a batch at once
+	typedef std::function<void(const ParticleArrays&, float)> ParticleBatchUpdate;
+
+	/// <summary>
+	/// Particle batch with its behavior chosen at run time. update() runs the built-in integration over
+	/// whole arrays (see integrateParticles), custom behavior comes as a batch update function that gets
+	/// the arrays, instead of a call per particle. Behaviors known at compile time are faster as a ParticleBatch2DT
+	/// </summary>
+	class ParticleBatch2D : public IParticleBatch2D
 	{
 	public:
 		ParticleBatch2D();
 		~ParticleBatch2D();
 
-		void init(int maxParticles, 
+		/// <summary>
+		/// per particle update function, called once for every live particle through a ParticleBatch2DT
+		/// style loop. Kept for existing callers, the overload below is much faster.
+		/// With a ParticleEngine2D ThreadPool it is called from several threads at once
+		/// </summary>
+		void init(int maxParticles,
 				  float decayRate,
-				  GLTexture m_texture,
+				  GLTexture texture,
 				  std::function<void(Particle2D&, float)> updateFunc = defaultParticleUpdate);
 
-		void update(float deltaTime);
-
-		void draw(SpriteBatch* spriteBatch);
+		/// <param name="batchUpdateFunc">runs before the integration, e.g. to apply forces, may be empty.
+		/// With a ParticleEngine2D ThreadPool it gets chunks of the particles, from several threads at once</param>
+		void init(int maxParticles,
+				  float decayRate,
+				  GLTexture texture,
+				  ParticleIntegration integration,
+				  ParticleBatchUpdate batchUpdateFunc = nullptr);
 
-		void addParticle(const glm::vec2& pos, const glm::vec2& velocity, 
-			const ColorRGBA8& color, float size);
+	protected:
+		void simulate(const ParticleArrays& particles, float deltaTime) override;
 
 	private:
-		int findFreeParticle();
-
-		std::function<void(Particle2D&, float)> m_updateFunc;
-
-		float m_decayRate = 0.1f;
-		Particle2D* m_particles = nullptr;
-		int m_maxParticles = 0;
-		int m_freeParticleIdx = 0;
-		GLTexture m_texture;
+		std::function<void(Particle2D&, float)> m_updateFunc; ///< empty unless init got a per particle function
+		ParticleBatchUpdate m_batchUpdateFunc;
+		ParticleIntegration m_integration = ParticleIntegration::MOVE;
 	};
 }
-
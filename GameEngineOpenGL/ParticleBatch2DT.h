@@ -0,0 +1,36 @@
+#pragma once
+#include "IParticleBatch2D.h"
+#include "ParticlePolicies.h"
+
+namespace ge {
+
+	/// <summary>
+	/// ParticleBatch2D with its behavior fixed at compile time. UpdatePolicy is one of the policies of
+	/// ParticlePolicies.h or several of them in a ParticlePolicies, update() runs it on every live particle
+	/// in a loop with no indirect call, e.g.
+	///     ParticleBatch2DT<ParticlePolicies<GravityPolicy, MovePolicy, FadePolicy>> sparks;
+	///     sparks.init(10000, 0.5f, texture, { GravityPolicy(glm::vec2(0.f, -200.f)), MovePolicy(), FadePolicy() });
+	/// </summary>
+	template<class UpdatePolicy>
+	class ParticleBatch2DT : public IParticleBatch2D
+	{
+	public:
+		void init(int maxParticles, float decayRate, const GLTexture& texture, const UpdatePolicy& policy = UpdatePolicy())
+		{
+			m_policy = policy;
+			allocate(maxParticles, decayRate, texture);
+		}
+
+		/// to change the behavior between updates, e.g. the acceleration of a GravityPolicy
+		UpdatePolicy& getPolicy() { return m_policy; }
+
+	protected:
+		void simulate(const ParticleArrays& particles, float deltaTime) override
+		{
+			updateParticles(particles, m_policy, deltaTime, m_decayRate);
+		}
+
+	private:
+		UpdatePolicy m_policy;
+	};
+}
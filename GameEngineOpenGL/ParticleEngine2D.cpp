@@ -1,6 +1,10 @@
 #include "ParticleEngine2D.h"
-#include "ParticleBatch2D.h"
+#include "IParticleBatch2D.h"
 #include "SpriteBatch.h"
+#include "RenderStats.h"
+#include "ThreadPool.h"
+#include "ParticleRenderer2D.h"
+#include <algorithm>
 
 
 namespace ge {
@@ -20,28 +24,76 @@ namespace ge {
 	/// becomes responsible for deallocation.
 	/// </summary>
 	/// <param name="particleBatch">Do not delete the batch, after passing it to this function</param>
-	void ParticleEngine2D::addParticleBatch(ParticleBatch2D * particleBatch)
+	void ParticleEngine2D::addParticleBatch(IParticleBatch2D * particleBatch)
 	{
 		m_batches.push_back(particleBatch);
 	}
 
 	void ParticleEngine2D::update(float deltaTime)
 	{
+		if (m_threadPool == nullptr) {
+			for (auto& b : m_batches) {
+				b->update(deltaTime);
+			}
+			return;
+		}
+
+		// spawning and removing the dead change the arrays, so those stay on this thread
+		const size_t chunkSize = UPDATE_CHUNK_SIZE;
+		m_updateJobs.clear();
+		for (auto& b : m_batches) {
+			b->mergeSpawnQueues();
+			const ParticleArrays& live = b->getLiveParticles();
+
+			// fixed chunk boundaries, the same particles share a SIMD register whatever the thread count
+			for (size_t first = 0; first < live.count; first += chunkSize) {
+				UpdateJob job;
+				job.batch = b;
+				job.particles = live;
+				job.particles.posX += first;
+				job.particles.posY += first;
+				job.particles.velX += first;
+				job.particles.velY += first;
+				job.particles.life += first;
+				job.particles.width += first;
+				job.particles.color += first;
+				job.particles.count = std::min(chunkSize, live.count - first);
+				m_updateJobs.push_back(job);
+			}
+		}
+
+		m_threadPool->parallelFor(m_updateJobs.size(), [this, deltaTime](size_t j) {
+			const UpdateJob& job = m_updateJobs[j];
+			job.batch->simulate(job.particles, deltaTime);
+		});
+
 		for (auto& b : m_batches) {
-			b->update(deltaTime);
+			b->removeDeadParticles();
 		}
 	}
 
-	void ParticleEngine2D::draw(SpriteBatch * spriteBatch)
+	void ParticleEngine2D::draw(SpriteBatch * spriteBatch, const Camera2D* cullCamera /* = nullptr */)
+	{
+		spriteBatch->begin(GlyphSortType::TEXTURE, cullCamera);
+		submit(spriteBatch);
+		spriteBatch->end();
+		spriteBatch->renderBatch();
+	}
+
+	void ParticleEngine2D::render(ParticleRenderer2D * renderer, const glm::mat4 & projectionMatrix)
+	{
+		renderer->render(m_batches.data(), m_batches.size(), projectionMatrix);
+	}
+
+	void ParticleEngine2D::submit(SpriteBatch * spriteBatch)
 	{
-		for (auto& b  : m_batches) {
-			spriteBatch->begin();
+		const size_t keptBefore = spriteBatch->getStats().keptSprites;
+
+		for (auto& b : m_batches) {
 			b->draw(spriteBatch);
-			spriteBatch->end();
-			spriteBatch->renderBatch();
 		}
 
-
+		RenderStats::current().particles += spriteBatch->getStats().keptSprites - keptBefore;
 	}
 
 }
\ No newline at end of file
@@ -1,10 +1,15 @@
 #pragma once
 #include <vector>
+#include <glm/glm.hpp>
+#include "ParticleIntegrator.h"
 
 namespace ge {
 
-	class ParticleBatch2D;
+	class IParticleBatch2D;
 	class SpriteBatch;
+	class Camera2D;
+	class ThreadPool;
+	class ParticleRenderer2D;
 
 	class ParticleEngine2D
 	{
@@ -12,14 +17,47 @@ namespace ge {
 		ParticleEngine2D();
 		~ParticleEngine2D();
 
-		void addParticleBatch(ParticleBatch2D* particleBatch);
+		void addParticleBatch(IParticleBatch2D* particleBatch);
 
+		/// <summary>
+		/// updates every batch. With a thread pool, the batches are cut into chunks of UPDATE_CHUNK_SIZE
+		/// particles that are all simulated in parallel. Every particle is computed the same way whatever
+		/// the number of threads, so replays stay deterministic
+		/// </summary>
 		void update(float deltaTime);
 
-		void draw(SpriteBatch* spriteBatch);
+		/// runs update() on pool, nullptr (the default) for the calling thread only
+		void setThreadPool(ThreadPool* pool) { m_threadPool = pool; }
+
+		/// particles per parallel update job, a multiple of the integrateParticles SIMD width
+		static const size_t UPDATE_CHUNK_SIZE = 8192;
+
+		/// <summary>
+		/// draws every particle batch in one begin/end/renderBatch cycle
+		/// </summary>
+		/// <param name="cullCamera">particles outside its view are skipped</param>
+		void draw(SpriteBatch* spriteBatch, const Camera2D* cullCamera = nullptr);
+
+		/// <summary>
+		/// adds every particle batch to a sprite batch that is already begun, e.g. RenderQueue::submit
+		/// </summary>
+		void submit(SpriteBatch* spriteBatch);
+
+		/// <summary>
+		/// draws every particle batch straight from its arrays, one instanced draw call per batch
+		/// </summary>
+		void render(ParticleRenderer2D* renderer, const glm::mat4& projectionMatrix);
 
 	private:
-		std::vector<ParticleBatch2D*> m_batches;
+		/// a chunk of one batch's live particles
+		struct UpdateJob {
+			IParticleBatch2D* batch;
+			ParticleArrays particles;
+		};
+
+		std::vector<IParticleBatch2D*> m_batches;
+		ThreadPool* m_threadPool = nullptr;
+		std::vector<UpdateJob> m_updateJobs; ///< kept to reuse its capacity
 	};
 
 }
@@ -0,0 +1,114 @@
+#include "ParticleIntegrator.h"
+#include <cstdint>
+
+#if defined(__AVX2__)
+#define GE_PARTICLE_AVX2
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GE_PARTICLE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ge {
+
+	namespace {
+
+		// alpha is the last byte of ColorRGBA8, the top one read as a little endian uint32
+		const uint32_t RGB_MASK = 0x00FFFFFF;
+
+		void integrateParticlesScalar(const ParticleArrays& p, size_t first, float deltaTime, float decay, bool fade)
+		{
+			for (size_t i = first; i < p.count; i++) {
+				p.posX[i] += p.velX[i] * deltaTime;
+				p.posY[i] += p.velY[i] * deltaTime;
+
+				if (fade) {
+					float alpha = p.life[i] * 255.f;
+					if (alpha < 0.f) alpha = 0.f;
+					if (alpha > 255.f) alpha = 255.f;
+					p.color[i].a = (GLubyte)alpha;
+				}
+
+				p.life[i] -= decay;
+			}
+		}
+
+#if defined(GE_PARTICLE_SSE2)
+		size_t integrateParticlesSSE2(const ParticleArrays& p, float deltaTime, float decay, bool fade)
+		{
+			const __m128 dt = _mm_set1_ps(deltaTime);
+			const __m128 dl = _mm_set1_ps(decay);
+			const __m128 scale = _mm_set1_ps(255.f);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128i rgbMask = _mm_set1_epi32((int)RGB_MASK);
+			size_t i = 0;
+
+			// 4 particles per iteration, lane k is particle i + k
+			for (; i + 4 <= p.count; i += 4) {
+				const __m128 x = _mm_loadu_ps(p.posX + i);
+				const __m128 y = _mm_loadu_ps(p.posY + i);
+				_mm_storeu_ps(p.posX + i, _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(p.velX + i), dt)));
+				_mm_storeu_ps(p.posY + i, _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(p.velY + i), dt)));
+
+				const __m128 life = _mm_loadu_ps(p.life + i);
+
+				if (fade) {
+					const __m128 alpha = _mm_min_ps(_mm_max_ps(_mm_mul_ps(life, scale), zero), scale);
+					__m128i color = _mm_loadu_si128((const __m128i*)(p.color + i));
+					color = _mm_or_si128(_mm_and_si128(color, rgbMask), _mm_slli_epi32(_mm_cvttps_epi32(alpha), 24));
+					_mm_storeu_si128((__m128i*)(p.color + i), color);
+				}
+
+				_mm_storeu_ps(p.life + i, _mm_sub_ps(life, dl));
+			}
+			return i;
+		}
+#endif
+
+#if defined(GE_PARTICLE_AVX2)
+		size_t integrateParticlesAVX2(const ParticleArrays& p, float deltaTime, float decay, bool fade)
+		{
+			const __m256 dt = _mm256_set1_ps(deltaTime);
+			const __m256 dl = _mm256_set1_ps(decay);
+			const __m256 scale = _mm256_set1_ps(255.f);
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256i rgbMask = _mm256_set1_epi32((int)RGB_MASK);
+			size_t i = 0;
+
+			// 8 particles per iteration, lane k is particle i + k
+			for (; i + 8 <= p.count; i += 8) {
+				const __m256 x = _mm256_loadu_ps(p.posX + i);
+				const __m256 y = _mm256_loadu_ps(p.posY + i);
+				_mm256_storeu_ps(p.posX + i, _mm256_add_ps(x, _mm256_mul_ps(_mm256_loadu_ps(p.velX + i), dt)));
+				_mm256_storeu_ps(p.posY + i, _mm256_add_ps(y, _mm256_mul_ps(_mm256_loadu_ps(p.velY + i), dt)));
+
+				const __m256 life = _mm256_loadu_ps(p.life + i);
+
+				if (fade) {
+					const __m256 alpha = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(life, scale), zero), scale);
+					__m256i color = _mm256_loadu_si256((const __m256i*)(p.color + i));
+					color = _mm256_or_si256(_mm256_and_si256(color, rgbMask), _mm256_slli_epi32(_mm256_cvttps_epi32(alpha), 24));
+					_mm256_storeu_si256((__m256i*)(p.color + i), color);
+				}
+
+				_mm256_storeu_ps(p.life + i, _mm256_sub_ps(life, dl));
+			}
+			return i;
+		}
+#endif
+	}
+
+	void integrateParticles(const ParticleArrays& particles, float deltaTime, float decayRate, bool fade)
+	{
+		// the same for every particle, computed once
+		const float decay = decayRate * deltaTime;
+
+		size_t done = 0;
+#if defined(GE_PARTICLE_AVX2)
+		done = integrateParticlesAVX2(particles, deltaTime, decay, fade);
+#elif defined(GE_PARTICLE_SSE2)
+		done = integrateParticlesSSE2(particles, deltaTime, decay, fade);
+#endif
+		integrateParticlesScalar(particles, done, deltaTime, decay, fade);
+	}
+}
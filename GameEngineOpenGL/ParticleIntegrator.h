@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include "Vertex.h"
+
+namespace ge {
+
+	/// <summary>
+	/// Particles stored as one array per attribute, index i of every array is particle i.
+	/// Dead particles have life <= 0
+	/// </summary>
+	struct ParticleArrays {
+		float* posX = nullptr;
+		float* posY = nullptr;
+		float* velX = nullptr;
+		float* velY = nullptr;
+		float* life = nullptr;
+		float* width = nullptr;
+		ColorRGBA8* color = nullptr;
+		size_t count = 0;
+	};
+
+	/// <summary>
+	/// Moves count particles by their velocity and decays their life, in one pass over the arrays.
+	/// Uses AVX2 (8 particles at a time) or SSE2 (4 at a time) when the compiler targets them,
+	/// plain C++ otherwise and for the remainder.
+	/// </summary>
+	/// <param name="fade">also sets the color alpha from the life before decaying, 255 at 1 and 0 at 0</param>
+	void integrateParticles(const ParticleArrays& particles, float deltaTime, float decayRate, bool fade);
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include <cstddef>
+#include <glm\glm.hpp>
+#include "Vertex.h"
+#include "ParticleIntegrator.h"
+
+namespace ge {
+
+	// Particle behaviors for ParticleBatch2DT. A policy is a copyable type with
+	//     void apply(const ParticleArrays& p, size_t i, float deltaTime) const;
+	// that updates particle i. They are called in a loop the compiler sees whole, so they get
+	// inlined into it and, when simple enough, vectorized.
+
+	/// pos += velocity * deltaTime
+	struct MovePolicy {
+		void apply(const ParticleArrays& p, size_t i, float deltaTime) const
+		{
+			p.posX[i] += p.velX[i] * deltaTime;
+			p.posY[i] += p.velY[i] * deltaTime;
+		}
+	};
+
+	/// constant acceleration, put it before MovePolicy
+	struct GravityPolicy {
+		GravityPolicy() {}
+		GravityPolicy(const glm::vec2& accel) : acceleration(accel) {}
+		glm::vec2 acceleration = glm::vec2(0.f, -9.8f);
+
+		void apply(const ParticleArrays& p, size_t i, float deltaTime) const
+		{
+			p.velX[i] += acceleration.x * deltaTime;
+			p.velY[i] += acceleration.y * deltaTime;
+		}
+	};
+
+	/// slows the particles down, drag is the velocity fraction lost per unit of time
+	struct DragPolicy {
+		DragPolicy() {}
+		DragPolicy(float dragVal) : drag(dragVal) {}
+		float drag = 0.1f;
+
+		void apply(const ParticleArrays& p, size_t i, float deltaTime) const
+		{
+			const float keep = 1.f - drag * deltaTime;
+			p.velX[i] *= keep;
+			p.velY[i] *= keep;
+		}
+	};
+
+	/// color alpha follows life, 255 at 1 and 0 at 0
+	struct FadePolicy {
+		void apply(const ParticleArrays& p, size_t i, float /* deltaTime */) const
+		{
+			p.color[i].a = lifeToByte(p.life[i], 0.f, 255.f);
+		}
+
+		/// from + (to - from) * life, clamped to a byte
+		static GLubyte lifeToByte(float life, float from, float to)
+		{
+			float v = from + (to - from) * life;
+			if (v < 0.f) v = 0.f;
+			if (v > 255.f) v = 255.f;
+			return (GLubyte)v;
+		}
+	};
+
+	/// color goes from start at life 1 to end at life 0, alpha included
+	struct ColorOverLifePolicy {
+		ColorOverLifePolicy() {}
+		ColorOverLifePolicy(const ColorRGBA8& startColor, const ColorRGBA8& endColor) :
+			start(startColor), end(endColor) {}
+		ColorRGBA8 start = ColorRGBA8(255, 255, 255, 255);
+		ColorRGBA8 end = ColorRGBA8(255, 255, 255, 0);
+
+		void apply(const ParticleArrays& p, size_t i, float /* deltaTime */) const
+		{
+			const float life = p.life[i];
+			ColorRGBA8& c = p.color[i];
+			c.r = FadePolicy::lifeToByte(life, end.r, start.r);
+			c.g = FadePolicy::lifeToByte(life, end.g, start.g);
+			c.b = FadePolicy::lifeToByte(life, end.b, start.b);
+			c.a = FadePolicy::lifeToByte(life, end.a, start.a);
+		}
+	};
+
+	/// <summary>
+	/// Runs several policies on every particle, in the order they are listed, e.g.
+	/// ParticlePolicies<GravityPolicy, DragPolicy, MovePolicy, FadePolicy>
+	/// </summary>
+	template<class... Policies>
+	struct ParticlePolicies;
+
+	template<>
+	struct ParticlePolicies<> {
+		void apply(const ParticleArrays& /* p */, size_t /* i */, float /* deltaTime */) const {}
+	};
+
+	template<class First, class... Rest>
+	struct ParticlePolicies<First, Rest...> {
+		ParticlePolicies() {}
+		ParticlePolicies(const First& firstPolicy, const Rest&... restPolicies) :
+			first(firstPolicy), rest(restPolicies...) {}
+
+		First first;
+		ParticlePolicies<Rest...> rest;
+
+		void apply(const ParticleArrays& p, size_t i, float deltaTime) const
+		{
+			first.apply(p, i, deltaTime);
+			rest.apply(p, i, deltaTime);
+		}
+	};
+
+	/// <summary>
+	/// Runs policy on every particle of p then decays its life, all in one loop
+	/// </summary>
+	template<class Policy>
+	void updateParticles(ParticleArrays p, const Policy& policy, float deltaTime, float decayRate)
+	{
+		// p is a copy, so the compiler knows the array pointers stay put in the loop
+		const float decay = decayRate * deltaTime;
+		for (size_t i = 0; i < p.count; i++) {
+			policy.apply(p, i, deltaTime);
+			p.life[i] -= decay;
+		}
+	}
+}
@@ -0,0 +1,172 @@
+#include "ParticleRenderer2D.h"
+#include "IParticleBatch2D.h"
+#include "ErrManager.h"
+#include "RenderStats.h"
+#include <cstring>
+
+namespace ge {
+
+#pragma region Shaders
+
+	const char* ParticleRenderer2D::VERT_SRC = R"(#version 130
+		//The vertex shader expands one particle into a square
+		//drawn as a 4 vertex triangle strip
+
+		in float particleX;
+		in float particleY;
+		in float particleWidth;
+		in vec4 particleColor;
+
+		out vec2 fragmentPosition;
+		out vec4 fragmentColor;
+		out vec2 fragmentUV;
+
+		uniform mat4 P;
+		uniform vec4 particleUV;
+
+		void main() {
+			//0 bottom left, 1 bottom right, 2 top left, 3 top right
+			vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+
+			vec2 pos = vec2(particleX, particleY) + corner * particleWidth;
+
+			gl_Position.xy = (P * vec4(pos, 0.0, 1.0)).xy;
+			gl_Position.z = 0.0;
+			gl_Position.w = 1.0;
+
+			fragmentPosition = pos;
+
+			fragmentColor = particleColor;
+
+			vec2 uv = particleUV.xy + corner * particleUV.zw;
+			fragmentUV = vec2(uv.x, 1.0 - uv.y);
+		})";
+
+	const char* ParticleRenderer2D::FRAG_SRC = R"(#version 130
+
+		in vec2 fragmentPosition;
+		in vec4 fragmentColor;
+		in vec2 fragmentUV;
+
+		out vec4 color;
+
+		uniform sampler2D mySampler;
+
+		void main() {
+			color = fragmentColor * texture(mySampler, fragmentUV);
+		})";
+
+#pragma endregion // Shaders
+
+	ParticleRenderer2D::ParticleRenderer2D() { /* empty */ }
+
+	ParticleRenderer2D::~ParticleRenderer2D() { /* empty */ }
+
+	void ParticleRenderer2D::init()
+	{
+		m_program.compileShadersFromSource(VERT_SRC, FRAG_SRC);
+		m_program.addAttribute("particleX");
+		m_program.addAttribute("particleY");
+		m_program.addAttribute("particleWidth");
+		m_program.addAttribute("particleColor");
+		m_program.linkShaders();
+
+		m_pLocation = m_program.getUniformLocation("P");
+		m_uvLocation = m_program.getUniformLocation("particleUV");
+		m_samplerLocation = m_program.getUniformLocation("mySampler");
+
+		// every array holds 4 byte elements
+		m_instanceBuffer.init(GL_ARRAY_BUFFER, 4);
+
+		GLCall(glGenVertexArrays(1, &m_vao));
+		GLCall(glBindVertexArray(m_vao));
+		for (GLuint i = 0; i < 4; i++) {
+			GLCall(glEnableVertexAttribArray(i));
+			GLCall(glVertexAttribDivisor(i, 1));
+		}
+		GLCall(glBindVertexArray(0));
+	}
+
+	void ParticleRenderer2D::render(IParticleBatch2D* const* batches, size_t count, const glm::mat4& projectionMatrix)
+	{
+		// the arrays of all the batches go in one region
+		size_t numParticles = 0;
+		for (size_t b = 0; b < count; b++) {
+			numParticles += batches[b]->getNumParticles();
+		}
+		if (numParticles == 0) { return; }
+
+		const size_t particleSize = 3 * sizeof(float) + sizeof(ColorRGBA8);
+		unsigned char* dest = (unsigned char*)m_instanceBuffer.map(numParticles * particleSize);
+		for (size_t b = 0; b < count; b++) {
+			const ParticleArrays& p = batches[b]->getLiveParticles();
+			const size_t floatBytes = p.count * sizeof(float);
+
+			std::memcpy(dest, p.posX, floatBytes); dest += floatBytes;
+			std::memcpy(dest, p.posY, floatBytes); dest += floatBytes;
+			std::memcpy(dest, p.width, floatBytes); dest += floatBytes;
+			std::memcpy(dest, p.color, p.count * sizeof(ColorRGBA8)); dest += p.count * sizeof(ColorRGBA8);
+		}
+		m_instanceBuffer.unmap();
+
+		m_program.use();
+		GLCall(glUniformMatrix4fv(m_pLocation, 1, GL_FALSE, &projectionMatrix[0][0]));
+		GLCall(glUniform1i(m_samplerLocation, 0));
+		GLCall(glActiveTexture(GL_TEXTURE0));
+
+		GLCall(glBindVertexArray(m_vao));
+		// map() may have reallocated the buffer, the pointers below pick up the current one
+		GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer.getId()));
+
+		FrameRenderStats& stats = RenderStats::current();
+		GLintptr offset = m_instanceBuffer.getOffset();
+		for (size_t b = 0; b < count; b++) {
+			const size_t n = batches[b]->getNumParticles();
+			if (n == 0) continue;
+
+			const GLTexture& texture = batches[b]->getTexture();
+			if (texture.target != GL_TEXTURE_2D) {
+				fatalError("ParticleRenderer2D: particle textures must be GL_TEXTURE_2D, layered textures need a LAYERED SpriteBatch");
+			}
+			const glm::vec4 uvRect = texture.subUV(glm::vec4(0.f, 0.f, 1.f, 1.f));
+			GLCall(glUniform4f(m_uvLocation, uvRect.x, uvRect.y, uvRect.z, uvRect.w));
+			GLCall(glBindTexture(GL_TEXTURE_2D, texture.id));
+
+			setInstanceAttribPointers(offset, n);
+			GLCall(glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)n));
+			offset += n * particleSize;
+
+			stats.drawCalls++;
+			stats.textureBinds++;
+			stats.particles += n;
+		}
+
+		m_instanceBuffer.fence();
+
+		GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+		GLCall(glBindVertexArray(0));
+		m_program.unuse();
+
+		stats.bytesUploaded += numParticles * particleSize;
+	}
+
+	void ParticleRenderer2D::setInstanceAttribPointers(GLintptr offset, size_t numParticles)
+	{
+		const GLintptr floatBytes = numParticles * sizeof(float);
+		GLCall(glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void *)offset));
+		GLCall(glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void *)(offset + floatBytes)));
+		GLCall(glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void *)(offset + 2 * floatBytes)));
+		GLCall(glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ColorRGBA8), (void *)(offset + 3 * floatBytes)));
+	}
+
+	void ParticleRenderer2D::dispose()
+	{
+		if (m_vao) {
+			GLCall(glDeleteVertexArrays(1, &m_vao));
+			m_vao = 0;
+		}
+		m_instanceBuffer.dispose();
+		m_program.dispose();
+	}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "GLSLProgram.h"
+#include "StreamBuffer.h"
+
+namespace ge {
+
+	class IParticleBatch2D;
+
+	/// <summary>
+	/// Draws particle batches without SpriteBatch: the particle arrays are copied as they are into
+	/// a streamed instance buffer, and every batch is one instanced draw call, with no sorting and
+	/// no per particle vertex work. The batch textures must be GL_TEXTURE_2D, atlas pages included,
+	/// render() stops with a fatalError on a layered one.
+	/// Uses whatever blending is set when render() is called
+	/// </summary>
+	class ParticleRenderer2D
+	{
+	public:
+		ParticleRenderer2D();
+		~ParticleRenderer2D();
+
+		/// compiles its program and creates the buffers, needs the GL context
+		void init();
+
+		/// <summary>
+		/// draws the live particles of count batches in that order. All of them share one upload
+		/// </summary>
+		void render(IParticleBatch2D* const* batches, size_t count, const glm::mat4& projectionMatrix);
+
+		/// frees the program and the buffers, needs the GL context, so the destructor doesn't call it
+		void dispose();
+
+		/// <summary>
+		/// Shaders of the renderer, every instance is a square expanded from gl_VertexID.
+		/// Attributes in this order: particleX, particleY, particleWidth, particleColor
+		/// </summary>
+		static const char* VERT_SRC;
+		static const char* FRAG_SRC;
+
+	private:
+		/// points the instance attributes at a batch's arrays, offset is where its posX starts in the buffer
+		void setInstanceAttribPointers(GLintptr offset, size_t numParticles);
+
+		GLSLProgram m_program;
+		StreamBuffer m_instanceBuffer; ///< posX, posY, width and color arrays of every batch, one after the other
+		GLuint m_vao = 0;
+		GLint m_pLocation = -1;
+		GLint m_uvLocation = -1;
+		GLint m_samplerLocation = -1;
+	};
+
+}
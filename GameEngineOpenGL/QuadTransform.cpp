@@ -0,0 +1,188 @@
+#include "QuadTransform.h"
+
+// only AVX float instructions, no AVX2 needed
+#if defined(__AVX__)
+#define GE_QUAD_AVX
+#include <immintrin.h>
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GE_QUAD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ge {
+
+	namespace {
+
+		// corners relative to the center in half extents: topLeft, bottomLeft, bottomRight, topRight
+		const float CORNER_X[4] = { -1.f, -1.f, 1.f, 1.f };
+		const float CORNER_Y[4] = { 1.f, -1.f, -1.f, 1.f };
+
+		void transformQuadsScalar(const glm::vec4* destRects, const glm::vec2* rotations, size_t count, glm::vec2* outCorners)
+		{
+			for (size_t q = 0; q < count; q++) {
+				const glm::vec4& r = destRects[q];
+				const float c = rotations[q].x;
+				const float s = rotations[q].y;
+
+				const float hx = r.z * 0.5f;
+				const float hy = r.w * 0.5f;
+				const float cx = r.x + hx;
+				const float cy = r.y + hy;
+
+				glm::vec2* out = outCorners + q * 4;
+				for (int k = 0; k < 4; k++) {
+					const float lx = CORNER_X[k] * hx;
+					const float ly = CORNER_Y[k] * hy;
+					out[k].x = cx + lx * c - ly * s;
+					out[k].y = cy + lx * s + ly * c;
+				}
+			}
+		}
+
+#if defined(GE_QUAD_SSE2) || defined(GE_QUAD_AVX)
+		/// loads x, y, width, height of 4 quads, one register per component
+		inline void loadRects4(const glm::vec4* destRects, __m128& x, __m128& y, __m128& w, __m128& h)
+		{
+			x = _mm_loadu_ps(&destRects[0].x);
+			y = _mm_loadu_ps(&destRects[1].x);
+			w = _mm_loadu_ps(&destRects[2].x);
+			h = _mm_loadu_ps(&destRects[3].x);
+			_MM_TRANSPOSE4_PS(x, y, w, h);
+		}
+
+		/// loads cos and sin of 4 quads, one register each
+		inline void loadRotations4(const glm::vec2* rotations, __m128& c, __m128& s)
+		{
+			__m128 r01 = _mm_loadu_ps(&rotations[0].x); // c0 s0 c1 s1
+			__m128 r23 = _mm_loadu_ps(&rotations[2].x); // c2 s2 c3 s3
+			c = _mm_shuffle_ps(r01, r23, _MM_SHUFFLE(2, 0, 2, 0));
+			s = _mm_shuffle_ps(r01, r23, _MM_SHUFFLE(3, 1, 3, 1));
+		}
+#endif
+
+#if defined(GE_QUAD_SSE2)
+		size_t transformQuadsSSE2(const glm::vec4* destRects, const glm::vec2* rotations, size_t count, glm::vec2* outCorners)
+		{
+			const __m128 half = _mm_set1_ps(0.5f);
+			size_t q = 0;
+
+			// 4 quads per iteration, lane i is quad q + i
+			for (; q + 4 <= count; q += 4) {
+				__m128 x, y, w, h, c, s;
+				loadRects4(destRects + q, x, y, w, h);
+				loadRotations4(rotations + q, c, s);
+
+				const __m128 hx = _mm_mul_ps(w, half);
+				const __m128 hy = _mm_mul_ps(h, half);
+				const __m128 cx = _mm_add_ps(x, hx);
+				const __m128 cy = _mm_add_ps(y, hy);
+
+				// the rotated half extents, every corner is a sign combination of them
+				const __m128 hxc = _mm_mul_ps(hx, c);
+				const __m128 hxs = _mm_mul_ps(hx, s);
+				const __m128 hyc = _mm_mul_ps(hy, c);
+				const __m128 hys = _mm_mul_ps(hy, s);
+
+				// topLeft: (-hx, hy), bottomLeft: (-hx, -hy), bottomRight: (hx, -hy), topRight: (hx, hy)
+				__m128 px[4], py[4];
+				px[0] = _mm_sub_ps(_mm_sub_ps(cx, hxc), hys);
+				py[0] = _mm_add_ps(_mm_sub_ps(cy, hxs), hyc);
+				px[1] = _mm_add_ps(_mm_sub_ps(cx, hxc), hys);
+				py[1] = _mm_sub_ps(_mm_sub_ps(cy, hxs), hyc);
+				px[2] = _mm_add_ps(_mm_add_ps(cx, hxc), hys);
+				py[2] = _mm_sub_ps(_mm_add_ps(cy, hxs), hyc);
+				px[3] = _mm_sub_ps(_mm_add_ps(cx, hxc), hys);
+				py[3] = _mm_add_ps(_mm_add_ps(cy, hxs), hyc);
+
+				// interleaving x and y back into the 4 corners of every quad
+				float* out = &outCorners[q * 4].x;
+				for (int k = 0; k < 4; k++) {
+					const __m128 lo = _mm_unpacklo_ps(px[k], py[k]); // quads 0, 1
+					const __m128 hi = _mm_unpackhi_ps(px[k], py[k]); // quads 2, 3
+					_mm_storel_pi((__m64*)(out + (0 * 4 + k) * 2), lo);
+					_mm_storeh_pi((__m64*)(out + (1 * 4 + k) * 2), lo);
+					_mm_storel_pi((__m64*)(out + (2 * 4 + k) * 2), hi);
+					_mm_storeh_pi((__m64*)(out + (3 * 4 + k) * 2), hi);
+				}
+			}
+			return q;
+		}
+#endif
+
+#if defined(GE_QUAD_AVX)
+		size_t transformQuadsAVX(const glm::vec4* destRects, const glm::vec2* rotations, size_t count, glm::vec2* outCorners)
+		{
+			const __m256 half = _mm256_set1_ps(0.5f);
+			size_t q = 0;
+
+			// 8 quads per iteration, quads q..q+3 in the low lane and q+4..q+7 in the high lane
+			for (; q + 8 <= count; q += 8) {
+				__m128 x0, y0, w0, h0, c0, s0;
+				__m128 x1, y1, w1, h1, c1, s1;
+				loadRects4(destRects + q, x0, y0, w0, h0);
+				loadRects4(destRects + q + 4, x1, y1, w1, h1);
+				loadRotations4(rotations + q, c0, s0);
+				loadRotations4(rotations + q + 4, c1, s1);
+
+				const __m256 x = _mm256_insertf128_ps(_mm256_castps128_ps256(x0), x1, 1);
+				const __m256 y = _mm256_insertf128_ps(_mm256_castps128_ps256(y0), y1, 1);
+				const __m256 w = _mm256_insertf128_ps(_mm256_castps128_ps256(w0), w1, 1);
+				const __m256 h = _mm256_insertf128_ps(_mm256_castps128_ps256(h0), h1, 1);
+				const __m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(c0), c1, 1);
+				const __m256 s = _mm256_insertf128_ps(_mm256_castps128_ps256(s0), s1, 1);
+
+				const __m256 hx = _mm256_mul_ps(w, half);
+				const __m256 hy = _mm256_mul_ps(h, half);
+				const __m256 cx = _mm256_add_ps(x, hx);
+				const __m256 cy = _mm256_add_ps(y, hy);
+
+				const __m256 hxc = _mm256_mul_ps(hx, c);
+				const __m256 hxs = _mm256_mul_ps(hx, s);
+				const __m256 hyc = _mm256_mul_ps(hy, c);
+				const __m256 hys = _mm256_mul_ps(hy, s);
+
+				__m256 px[4], py[4];
+				px[0] = _mm256_sub_ps(_mm256_sub_ps(cx, hxc), hys);
+				py[0] = _mm256_add_ps(_mm256_sub_ps(cy, hxs), hyc);
+				px[1] = _mm256_add_ps(_mm256_sub_ps(cx, hxc), hys);
+				py[1] = _mm256_sub_ps(_mm256_sub_ps(cy, hxs), hyc);
+				px[2] = _mm256_add_ps(_mm256_add_ps(cx, hxc), hys);
+				py[2] = _mm256_sub_ps(_mm256_add_ps(cy, hxs), hyc);
+				px[3] = _mm256_sub_ps(_mm256_add_ps(cx, hxc), hys);
+				py[3] = _mm256_add_ps(_mm256_add_ps(cy, hxs), hyc);
+
+				// unpack works per 128 bit lane, so quad order is 0 1 4 5 | 2 3 6 7
+				float* out = &outCorners[q * 4].x;
+				for (int k = 0; k < 4; k++) {
+					const __m256 lo = _mm256_unpacklo_ps(px[k], py[k]);
+					const __m256 hi = _mm256_unpackhi_ps(px[k], py[k]);
+					const __m128 lo0 = _mm256_castps256_ps128(lo);
+					const __m128 lo1 = _mm256_extractf128_ps(lo, 1);
+					const __m128 hi0 = _mm256_castps256_ps128(hi);
+					const __m128 hi1 = _mm256_extractf128_ps(hi, 1);
+					_mm_storel_pi((__m64*)(out + (0 * 4 + k) * 2), lo0);
+					_mm_storeh_pi((__m64*)(out + (1 * 4 + k) * 2), lo0);
+					_mm_storel_pi((__m64*)(out + (2 * 4 + k) * 2), hi0);
+					_mm_storeh_pi((__m64*)(out + (3 * 4 + k) * 2), hi0);
+					_mm_storel_pi((__m64*)(out + (4 * 4 + k) * 2), lo1);
+					_mm_storeh_pi((__m64*)(out + (5 * 4 + k) * 2), lo1);
+					_mm_storel_pi((__m64*)(out + (6 * 4 + k) * 2), hi1);
+					_mm_storeh_pi((__m64*)(out + (7 * 4 + k) * 2), hi1);
+				}
+			}
+			return q;
+		}
+#endif
+	}
+
+	void transformQuads(const glm::vec4* destRects, const glm::vec2* rotations, size_t count, glm::vec2* outCorners)
+	{
+		size_t done = 0;
+#if defined(GE_QUAD_AVX)
+		done = transformQuadsAVX(destRects, rotations, count, outCorners);
+#elif defined(GE_QUAD_SSE2)
+		done = transformQuadsSSE2(destRects, rotations, count, outCorners);
+#endif
+		transformQuadsScalar(destRects + done, rotations + done, count - done, outCorners + done * 4);
+	}
+}
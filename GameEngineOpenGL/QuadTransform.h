@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cmath>
+#include <glm\glm.hpp>
+
+namespace ge {
+
+	/// <summary>
+	/// (cos, sin) pair of a rotation, sin and cos get computed once per sprite
+	/// </summary>
+	inline glm::vec2 rotationFromAngle(float angle)
+	{
+		return glm::vec2(std::cos(angle), std::sin(angle));
+	}
+
+	/// <summary>
+	/// rotation that turns (1,0) into dir, no trig needed. dir may be any length, e.g. a velocity,
+	/// only its direction counts. A zero dir gives no rotation
+	/// </summary>
+	inline glm::vec2 rotationFromDir(const glm::vec2& dir)
+	{
+		const float lengthSq = dir.x * dir.x + dir.y * dir.y;
+		if (lengthSq == 0.f) { return glm::vec2(1.f, 0.f); }
+
+		// a unit dir already is the (cos, sin) pair
+		return dir * (1.f / std::sqrt(lengthSq));
+	}
+
+	/// <summary>
+	/// Rotates count quads about their centers and writes their 4 corners,
+	/// topLeft, bottomLeft, bottomRight, topRight, to outCorners (4 per quad).
+	/// Uses AVX (8 quads at a time) or SSE2 (4 at a time) when the compiler targets them,
+	/// plain C++ otherwise and for the remainder.
+	/// </summary>
+	/// <param name="destRects">x, y, width, height of the unrotated quads</param>
+	/// <param name="rotations">(cos, sin) of every quad</param>
+	void transformQuads(const glm::vec4* destRects, const glm::vec2* rotations, size_t count, glm::vec2* outCorners);
+}
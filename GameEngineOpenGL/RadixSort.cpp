@@ -0,0 +1,92 @@
+#include "RadixSort.h"
+#include <utility>
+#include <algorithm>
+
+namespace ge {
+
+	void radixSort(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch, int firstByte /* = 0 */)
+	{
+		const size_t n = keys.size();
+		if (n < 2) { return; }
+
+		const int NUM_BYTES = 8;
+
+		// all the histograms are built in a single read of the keys
+		size_t counts[NUM_BYTES][256] = {};
+		for (size_t i = 0; i < n; i++) {
+			uint64_t key = keys[i];
+			for (int b = firstByte; b < NUM_BYTES; b++) {
+				counts[b][(key >> (b * 8)) & 0xFF]++;
+			}
+		}
+
+		scratch.resize(n);
+		uint64_t* src = keys.data();
+		uint64_t* dst = scratch.data();
+
+		for (int b = firstByte; b < NUM_BYTES; b++) {
+			const int shift = b * 8;
+			size_t* count = counts[b];
+
+			// every key has the same digit, the pass would not move anything
+			if (count[(src[0] >> shift) & 0xFF] == n) { continue; }
+
+			// turning the histogram into start offsets
+			size_t sum = 0;
+			for (int d = 0; d < 256; d++) {
+				size_t c = count[d];
+				count[d] = sum;
+				sum += c;
+			}
+
+			for (size_t i = 0; i < n; i++) {
+				dst[count[(src[i] >> shift) & 0xFF]++] = src[i];
+			}
+
+			std::swap(src, dst);
+		}
+
+		// an odd number of passes leaves the result in the scratch buffer
+		if (src != keys.data()) {
+			keys.swap(scratch);
+		}
+	}
+
+	bool mergeSortedRuns(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch, size_t maxRuns)
+	{
+		const size_t n = keys.size();
+
+		// where every run starts, n closes the last one
+		size_t starts[MAX_MERGE_RUNS + 1];
+		if (maxRuns > MAX_MERGE_RUNS) maxRuns = MAX_MERGE_RUNS;
+
+		size_t numRuns = 1;
+		starts[0] = 0;
+		for (size_t i = 1; i < n; i++) {
+			if (keys[i] < keys[i - 1]) {
+				if (numRuns == maxRuns) { return false; }
+				starts[numRuns++] = i;
+			}
+		}
+		starts[numRuns] = n;
+
+		if (numRuns == 1) { return true; }
+
+		// merging neighbouring runs until one is left
+		scratch.resize(n);
+		while (numRuns > 1) {
+			size_t merged = 0;
+			for (size_t r = 0; r < numRuns; r += 2) {
+				const size_t a = starts[r];
+				const size_t b = starts[r + 1];
+				const size_t c = r + 2 <= numRuns ? starts[r + 2] : n;
+				std::merge(keys.begin() + a, keys.begin() + b, keys.begin() + b, keys.begin() + c, scratch.begin() + a);
+				starts[merged++] = a;
+			}
+			starts[merged] = n;
+			numRuns = merged;
+			keys.swap(scratch);
+		}
+		return true;
+	}
+}
\ No newline at end of file
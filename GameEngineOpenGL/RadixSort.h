@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ge {
+
+	/// <summary>
+	/// Stable LSD radix sort of 64-bit keys, one byte per pass.
+	/// Passes where every key shares the same byte are skipped.
+	/// </summary>
+	/// <param name="scratch">reused between calls to avoid allocations</param>
+	/// <param name="firstByte">bytes below it are left as they are, e.g. a submission index that is already ascending</param>
+	void radixSort(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch, int firstByte = 0);
+
+	/// upper limit for mergeSortedRuns' maxRuns
+	static const size_t MAX_MERGE_RUNS = 64;
+
+	/// <summary>
+	/// Sorts keys made of a few ascending runs by merging them, O(n log runs).
+	/// Leaves the keys untouched and returns false when there are more than maxRuns runs.
+	/// An already sorted input is a single run and costs one read.
+	/// </summary>
+	bool mergeSortedRuns(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch, size_t maxRuns);
+
+	/// Maps a float to an unsigned int with the same ordering
+	inline uint32_t floatToSortable(float f) {
+		union { float f; uint32_t u; } bits;
+		bits.f = f;
+		// negative numbers flip entirely, positive ones just get the sign bit set
+		return (bits.u & 0x80000000u) ? ~bits.u : (bits.u | 0x80000000u);
+	}
+}
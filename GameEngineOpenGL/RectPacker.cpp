@@ -0,0 +1,93 @@
+#include "RectPacker.h"
+
+namespace ge {
+
+	RectPacker::RectPacker() { /* empty */ }
+
+	RectPacker::~RectPacker() { /* empty */ }
+
+	void RectPacker::init(int width, int height)
+	{
+		m_width = width;
+		m_height = height;
+
+		m_skyline.clear();
+		m_skyline.push_back({ 0, 0, width });
+	}
+
+	bool RectPacker::pack(int w, int h, glm::ivec2& outPos)
+	{
+		int bestY = m_height;
+		int bestWidth = m_width + 1;
+		size_t bestNode = m_skyline.size();
+
+		// lowest position wins, the narrower segment breaks ties
+		for (size_t i = 0; i < m_skyline.size(); i++) {
+			int y = fit(i, w, h);
+			if (y < 0) continue;
+
+			if (y < bestY || (y == bestY && m_skyline[i].w < bestWidth)) {
+				bestY = y;
+				bestWidth = m_skyline[i].w;
+				bestNode = i;
+			}
+		}
+
+		if (bestNode == m_skyline.size()) {
+			return false;
+		}
+
+		outPos = glm::ivec2(m_skyline[bestNode].x, bestY);
+
+		// the rect becomes a new segment of the skyline...
+		SkylineNode node = { outPos.x, bestY + h, w };
+		m_skyline.insert(m_skyline.begin() + bestNode, node);
+
+		// ...and shadows the segments it covers
+		for (size_t i = bestNode + 1; i < m_skyline.size(); ) {
+			SkylineNode& curr = m_skyline[i];
+			const int shadowEnd = node.x + node.w;
+			if (curr.x >= shadowEnd) break;
+
+			int shrink = shadowEnd - curr.x;
+			if (curr.w <= shrink) {
+				m_skyline.erase(m_skyline.begin() + i);
+				continue;
+			}
+			curr.x += shrink;
+			curr.w -= shrink;
+			break;
+		}
+
+		// merging neighbours of the same height
+		for (size_t i = 0; i + 1 < m_skyline.size(); ) {
+			if (m_skyline[i].y == m_skyline[i + 1].y) {
+				m_skyline[i].w += m_skyline[i + 1].w;
+				m_skyline.erase(m_skyline.begin() + i + 1);
+			}
+			else {
+				i++;
+			}
+		}
+
+		return true;
+	}
+
+	int RectPacker::fit(size_t i, int w, int h) const
+	{
+		int x = m_skyline[i].x;
+		if (x + w > m_width) return -1;
+
+		// the rect rests on the highest segment it spans
+		int y = 0;
+		int remaining = w;
+		while (remaining > 0) {
+			if (i == m_skyline.size()) return -1;
+			if (m_skyline[i].y > y) y = m_skyline[i].y;
+			if (y + h > m_height) return -1;
+			remaining -= m_skyline[i].w;
+			i++;
+		}
+		return y;
+	}
+}
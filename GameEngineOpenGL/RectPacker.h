@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+#include <glm\glm.hpp>
+
+namespace ge {
+
+	/// <summary>
+	/// Skyline bottom-left rectangle packer, used to place textures in atlas pages.
+	/// Keeps the top edge of the packed area as a list of horizontal segments
+	/// and puts every new rect where it ends up lowest.
+	/// </summary>
+	class RectPacker
+	{
+	public:
+		RectPacker();
+		~RectPacker();
+
+		void init(int width, int height);
+
+		/// <summary>
+		/// Finds room for a w*h rect, returns false when the page is full
+		/// </summary>
+		/// <param name="outPos">bottom-left corner of the placed rect</param>
+		bool pack(int w, int h, glm::ivec2& outPos);
+
+		// getters
+		int getWidth() const { return m_width; }
+		int getHeight() const { return m_height; }
+
+	private:
+		struct SkylineNode {
+			int x, y, w;
+		};
+
+		/// height the rect would be placed at when starting on node i, -1 if it doesn't fit
+		int fit(size_t i, int w, int h) const;
+
+		int m_width = 0;
+		int m_height = 0;
+		std::vector<SkylineNode> m_skyline;
+	};
+}
@@ -0,0 +1,79 @@
+#include "RenderQueue.h"
+#include "Camera2D.h"
+#include "GLSLProgram.h"
+#include "ErrManager.h"
+
+namespace ge {
+
+	void RenderQueue::init(VertexUpload upload /* = VertexUpload::ORPHAN */, VertexFormat format /* = VertexFormat::STANDARD */)
+	{
+		m_batch.init(upload, format);
+	}
+
+	void RenderQueue::dispose()
+	{
+		m_batch.dispose();
+	}
+
+	void RenderQueue::setLayer(uint8_t layer, Camera2D * camera, GLSLProgram * program, bool cull /* = false */)
+	{
+		if (m_layers.size() <= layer) {
+			m_layers.resize(layer + 1);
+		}
+
+		Layer& l = m_layers[layer];
+		l.camera = camera;
+		l.program = program;
+		l.cull = cull;
+	}
+
+	void RenderQueue::begin(GlyphSortType sortBy /* = GlyphSortType::TEXTURE */)
+	{
+		for (auto& l : m_layers) {
+			l.used = false;
+		}
+		m_batch.begin(sortBy);
+	}
+
+	SpriteBatch & RenderQueue::submit(uint8_t layer)
+	{
+		if (layer >= m_layers.size() || m_layers[layer].program == nullptr) {
+			fatalError("RenderQueue: layer " + std::to_string(layer) + " was never set");
+		}
+
+		Layer& l = m_layers[layer];
+		l.used = true;
+		m_batch.setRenderLayer(layer, l.cull ? l.camera : nullptr);
+		return m_batch;
+	}
+
+	void RenderQueue::end()
+	{
+		// one sort and one upload for all the layers
+		m_batch.end();
+	}
+
+	void RenderQueue::render()
+	{
+		renderLayers(0, 255);
+	}
+
+	void RenderQueue::renderLayers(uint8_t first, uint8_t last)
+	{
+		for (size_t i = first; i < m_layers.size() && i <= last; i++) {
+			Layer& l = m_layers[i];
+			if (!l.used) continue;
+
+			l.program->use();
+
+			glm::mat4 cameraMatrix = l.camera->getCameraMatrix();
+			GLint pLocation = l.program->getUniformLocation("P");
+			GLCall(glUniformMatrix4fv(pLocation, 1, GL_FALSE, &cameraMatrix[0][0]));
+
+			m_batch.renderLayer((uint8_t)i);
+
+			l.program->unuse();
+		}
+	}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "SpriteBatch.h"
+
+namespace ge {
+
+	class Camera2D;
+	class GLSLProgram;
+
+	/// <summary>
+	/// One SpriteBatch shared by everything drawn in a frame. Each submitter draws into a layer,
+	/// and every layer has its own camera and program. end() sorts and uploads all the layers at once,
+	/// render() then draws them from the lowest layer up.
+	/// </summary>
+	class RenderQueue
+	{
+	public:
+		void init(VertexUpload upload = VertexUpload::ORPHAN, VertexFormat format = VertexFormat::STANDARD);
+		void dispose();
+
+		/// <summary>
+		/// sets what a layer is drawn with, kept between frames
+		/// </summary>
+		/// <param name="camera">its matrix goes to the "P" uniform of program, other uniforms are left to the caller</param>
+		/// <param name="cull">drops the sprites outside the camera's view</param>
+		void setLayer(uint8_t layer, Camera2D* camera, GLSLProgram* program, bool cull = false);
+
+		void begin(GlyphSortType sortBy = GlyphSortType::TEXTURE);
+
+		/// <summary>
+		/// the batch to draw layer's sprites into, until the next submit() or end().
+		/// Its addSubmitBuffers() gives buffers that fill the layer from several threads
+		/// </summary>
+		SpriteBatch& submit(uint8_t layer);
+
+		void end();
+
+		/// <summary>
+		/// draws every layer with sprites, binding its program and camera
+		/// </summary>
+		void render();
+		/// <summary>
+		/// same for the layers from first to last only, so other renderers can draw in between
+		/// </summary>
+		void renderLayers(uint8_t first, uint8_t last);
+
+	private:
+		struct Layer {
+			Camera2D* camera = nullptr;
+			GLSLProgram* program = nullptr;
+			bool cull = false;
+			bool used = false; ///< submitted to this frame
+		};
+
+		SpriteBatch m_batch;
+		std::vector<Layer> m_layers;
+	};
+
+}
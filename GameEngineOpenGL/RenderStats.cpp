@@ -0,0 +1,88 @@
+#include "RenderStats.h"
+#include <algorithm>
+
+namespace ge {
+
+	FrameRenderStats RenderStats::m_current;
+	FrameRenderStats RenderStats::m_lastFrame;
+	std::vector<FrameRenderStats> RenderStats::m_history(60);
+	size_t RenderStats::m_historyHead = 0;
+	size_t RenderStats::m_numFrames = 0;
+
+	void RenderStats::endFrame()
+	{
+		m_lastFrame = m_current;
+		m_current = FrameRenderStats();
+
+		m_history[m_historyHead] = m_lastFrame;
+		m_historyHead = (m_historyHead + 1) % m_history.size();
+		if (m_numFrames < m_history.size()) {
+			m_numFrames++;
+		}
+	}
+
+	void RenderStats::setHistorySize(size_t numFrames)
+	{
+		if (numFrames == 0) numFrames = 1;
+
+		m_history.assign(numFrames, FrameRenderStats());
+		m_historyHead = 0;
+		m_numFrames = 0;
+	}
+
+	FrameRenderStats RenderStats::getAverage()
+	{
+		FrameRenderStats avg;
+		if (m_numFrames == 0) { return avg; }
+
+		for (size_t i = 0; i < m_numFrames; i++) {
+			const FrameRenderStats& f = m_history[i];
+			avg.sprites += f.sprites;
+			avg.culledSprites += f.culledSprites;
+			avg.renderBatches += f.renderBatches;
+			avg.drawCalls += f.drawCalls;
+			avg.textureBinds += f.textureBinds;
+			avg.stateChanges += f.stateChanges;
+			avg.bytesUploaded += f.bytesUploaded;
+			avg.fastSorts += f.fastSorts;
+			avg.fullSorts += f.fullSorts;
+			avg.particles += f.particles;
+			avg.debugElements += f.debugElements;
+		}
+
+		avg.sprites /= m_numFrames;
+		avg.culledSprites /= m_numFrames;
+		avg.renderBatches /= m_numFrames;
+		avg.drawCalls /= m_numFrames;
+		avg.textureBinds /= m_numFrames;
+		avg.stateChanges /= m_numFrames;
+		avg.bytesUploaded /= m_numFrames;
+		avg.fastSorts /= m_numFrames;
+		avg.fullSorts /= m_numFrames;
+		avg.particles /= m_numFrames;
+		avg.debugElements /= m_numFrames;
+		return avg;
+	}
+
+	FrameRenderStats RenderStats::getPeak()
+	{
+		FrameRenderStats peak;
+
+		// the history isn't full yet when m_numFrames < size, so the first m_numFrames are the valid ones
+		for (size_t i = 0; i < m_numFrames; i++) {
+			const FrameRenderStats& f = m_history[i];
+			peak.sprites = std::max(peak.sprites, f.sprites);
+			peak.culledSprites = std::max(peak.culledSprites, f.culledSprites);
+			peak.renderBatches = std::max(peak.renderBatches, f.renderBatches);
+			peak.drawCalls = std::max(peak.drawCalls, f.drawCalls);
+			peak.textureBinds = std::max(peak.textureBinds, f.textureBinds);
+			peak.stateChanges = std::max(peak.stateChanges, f.stateChanges);
+			peak.bytesUploaded = std::max(peak.bytesUploaded, f.bytesUploaded);
+			peak.fastSorts = std::max(peak.fastSorts, f.fastSorts);
+			peak.fullSorts = std::max(peak.fullSorts, f.fullSorts);
+			peak.particles = std::max(peak.particles, f.particles);
+			peak.debugElements = std::max(peak.debugElements, f.debugElements);
+		}
+		return peak;
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace ge {
+
+	/// What the renderers submitted during one frame
+	struct FrameRenderStats {
+		size_t sprites = 0; ///< sprites drawn by SpriteBatch and StaticSpriteBatch
+		size_t culledSprites = 0; ///< sprites SpriteBatch dropped off screen
+		size_t renderBatches = 0;
+		size_t drawCalls = 0;
+		size_t textureBinds = 0;
+		size_t stateChanges = 0; ///< program and blend switches between SpriteBatch materials
+		size_t bytesUploaded = 0; ///< vertex, instance and index data sent to buffers
+		size_t fastSorts = 0; ///< SpriteBatch sorts skipped or done by merging runs
+		size_t fullSorts = 0;
+		size_t particles = 0; ///< drawn by ParticleEngine2D
+		size_t debugElements = 0; ///< DebugRenderer line indices
+	};
+
+	/// <summary>
+	/// Frame counters fed by SpriteBatch, StaticSpriteBatch, DebugRenderer and ParticleEngine2D.
+	/// Window::swapBuffer closes the frame, so budgets can be checked per frame or over the last N frames.
+	/// </summary>
+	class RenderStats
+	{
+	public:
+		/// the frame being recorded, renderers add to it
+		static FrameRenderStats& current() { return m_current; }
+
+		/// stores the current frame in the history and starts a new one
+		static void endFrame();
+
+		/// how many finished frames getAverage and getPeak look at, 60 by default
+		static void setHistorySize(size_t numFrames);
+
+		// getters
+		static const FrameRenderStats& getLastFrame() { return m_lastFrame; }
+		static FrameRenderStats getAverage();
+		/// every counter's highest value over the history
+		static FrameRenderStats getPeak();
+		static size_t getNumFrames() { return m_numFrames; }
+
+	private:
+		static FrameRenderStats m_current;
+		static FrameRenderStats m_lastFrame;
+		static std::vector<FrameRenderStats> m_history; ///< ring of the last finished frames
+		static size_t m_historyHead;
+		static size_t m_numFrames; ///< in the history
+	};
+}
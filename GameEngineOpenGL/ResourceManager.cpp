@@ -7,4 +7,14 @@ namespace ge {
 	{
 		return textureCache.getTexture(texturePath);
 	}
+
+	void ResourceManager::enableTextureAtlas(int pageSize /* = 2048 */)
+	{
+		textureCache.enableAtlas(pageSize);
+	}
+
+	GLTexture ResourceManager::getLayeredTexture(std::string texturePath)
+	{
+		return textureCache.getLayeredTexture(texturePath);
+	}
 }
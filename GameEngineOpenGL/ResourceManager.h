@@ -12,6 +12,16 @@ namespace ge {
 	public:
 		static GLTexture getTexture(std::string texturePath);
 
+		/// <summary>
+		/// Packs the textures loaded from now on into shared atlas pages, so sprites
+		/// with different textures can share a batch. Use GLTexture::uvRect (or the
+		/// SpriteBatch::draw overload taking a GLTexture) to sample them.
+		/// </summary>
+		static void enableTextureAtlas(int pageSize = 2048);
+
+		/// same sized textures share a GL_TEXTURE_2D_ARRAY, for VertexFormat::LAYERED sprite batches
+		static GLTexture getLayeredTexture(std::string texturePath);
+
 	private:
 		static TextureCache textureCache;
 	};
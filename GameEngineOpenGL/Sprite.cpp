@@ -36,21 +36,26 @@ namespace ge {
 
 		Vertex vertexData[12]; // 6 vertecies with 2 floats
 
+		// the texture may be a part of an atlas page
+		const glm::vec4& uv = m_texture.uvRect;
+		const float u0 = uv.x, u1 = uv.x + uv.z;
+		const float v0 = uv.y, v1 = uv.y + uv.w;
+
 		// first triangle
 		vertexData[0].setPos(x + w, y + h); // top right
-		vertexData[0].setUV(1.0f, 1.0f);
+		vertexData[0].setUV(u1, v1);
 		vertexData[1].setPos(x, y + h);     // top left
-		vertexData[1].setUV(0.0f, 1.0f);
+		vertexData[1].setUV(u0, v1);
 		vertexData[2].setPos(x, y);         // bottom left
-		vertexData[2].setUV(0.0f, 0.0f);
+		vertexData[2].setUV(u0, v0);
 
 		// second triangle
 		vertexData[3].setPos(x, y);         // bottom left
-		vertexData[3].setUV(0.0f, 0.0f);
+		vertexData[3].setUV(u0, v0);
 		vertexData[4].setPos(x + w, y);		// bottom right
-		vertexData[4].setUV(1.0f, 0.0f);
+		vertexData[4].setUV(u1, v0);
 		vertexData[5].setPos(x + w, y + h); // top right
-		vertexData[5].setUV(1.0f, 1.0f);
+		vertexData[5].setUV(u1, v1);
 
 		for (auto i = 0; i < 6; i++) {
 			vertexData[i].setColor(255, 0, 255, 255);
@@ -1,194 +1,1257 @@
 #include "SpriteBatch.h"
 #include "ErrManager.h"
-#include <algorithm>
+#include "RadixSort.h"
+#include "QuadTransform.h"
+#include "Camera2D.h"
+#include "RenderStats.h"
+#include "GLSLProgram.h"
+#include <cstring>
+#include <cmath>
 
 namespace ge {
 
-	Glyph::Glyph(const glm::vec4 & destRect, const glm::vec4 & uvRect, GLuint m_texture, float depth, const ColorRGBA8 & color) :
-		m_texture(m_texture),
-		depth(depth)
+#pragma region Shaders
+
+	const char* SpriteBatch::INSTANCED_VERT_SRC = R"(#version 130
+		//The vertex shader expands one instance into a quad
+		//drawn as a 4 vertex triangle strip
+
+		in vec4 instanceDestRect;
+		in vec4 instanceUV;
+		in vec4 instanceColor;
+		in vec2 instanceRotation;
+
+		//both names are used by the game fragment shaders
+		out vec2 fragmentPosition;
+		out vec2 fragmentPos;
+		out vec4 fragmentColor;
+		out vec2 fragmentUV;
+
+		uniform mat4 P;
+
+		void main() {
+			//0 bottom left, 1 bottom right, 2 top left, 3 top right
+			vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+
+			//rotating about the center of destRect
+			vec2 halfDims = instanceDestRect.zw * 0.5;
+			vec2 local = (corner - 0.5) * instanceDestRect.zw;
+			float c = instanceRotation.x;
+			float s = instanceRotation.y;
+			vec2 pos = instanceDestRect.xy + halfDims +
+				vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+			gl_Position.xy = (P * vec4(pos, 0.0, 1.0)).xy;
+			gl_Position.z = 0.0;
+			gl_Position.w = 1.0;
+
+			fragmentPosition = pos;
+			fragmentPos = pos;
+
+			fragmentColor = instanceColor;
+
+			vec2 uv = instanceUV.xy + corner * instanceUV.zw;
+			fragmentUV = vec2(uv.x, 1.0 - uv.y);
+		})";
+
+	const char* SpriteBatch::LAYERED_VERT_SRC = R"(#version 130
+		//Same as the game texture shaders, plus the texture array layer
+
+		in vec2 vertexPosition;
+		in vec4 vertexColor;
+		in vec2 vertexUV;
+		in float vertexLayer;
+
+		out vec2 fragmentPosition;
+		out vec4 fragmentColor;
+		out vec3 fragmentUV;
+
+		uniform mat4 P;
+
+		void main() {
+			gl_Position.xy = (P * vec4(vertexPosition, 0.0, 1.0)).xy;
+			gl_Position.z = 0.0;
+			gl_Position.w = 1.0;
+
+			fragmentPosition = vertexPosition;
+
+			fragmentColor = vertexColor;
+
+			fragmentUV = vec3(vertexUV.x, 1.0 - vertexUV.y, vertexLayer);
+		})";
+
+	const char* SpriteBatch::LAYERED_FRAG_SRC = R"(#version 130
+
+		in vec2 fragmentPosition;
+		in vec4 fragmentColor;
+		in vec3 fragmentUV;
+
+		out vec4 color;
+
+		uniform sampler2DArray mySampler;
+
+		void main() {
+			color = fragmentColor * texture(mySampler, fragmentUV);
+		})";
+
+	const char* SpriteBatch::COMPACT_VERT_SRC = R"(#version 130
+		//Same as the game texture shaders, but the positions are
+		//1/8 unit fixed point offsets from the batch origin
+
+		in vec2 vertexPosition;
+		in vec4 vertexColor;
+		in vec2 vertexUV;
+		in vec2 vertexOrigin;
+
+		//both names are used by the game fragment shaders
+		out vec2 fragmentPosition;
+		out vec2 fragmentPos;
+		out vec4 fragmentColor;
+		out vec2 fragmentUV;
+
+		uniform mat4 P;
+
+		void main() {
+			vec2 pos = vertexOrigin + vertexPosition * 0.125;
+
+			gl_Position.xy = (P * vec4(pos, 0.0, 1.0)).xy;
+			gl_Position.z = 0.0;
+			gl_Position.w = 1.0;
+
+			fragmentPosition = pos;
+			fragmentPos = pos;
+
+			fragmentColor = vertexColor;
+
+			fragmentUV = vec2(vertexUV.x, 1.0 - vertexUV.y);
+		})";
+
+	const char* SpriteBatch::DEPTH_VERT_SRC = R"(#version 130
+		//Same as the game texture shaders, the depth is vertexPosition.z
+
+		in vec3 vertexPosition;
+		in vec4 vertexColor;
+		in vec2 vertexUV;
+
+		//both names are used by the game fragment shaders
+		out vec2 fragmentPosition;
+		out vec2 fragmentPos;
+		out vec4 fragmentColor;
+		out vec2 fragmentUV;
+
+		uniform mat4 P;
+
+		void main() {
+			gl_Position.xy = (P * vec4(vertexPosition.xy, 0.0, 1.0)).xy;
+			gl_Position.z = vertexPosition.z;
+			gl_Position.w = 1.0;
+
+			fragmentPosition = vertexPosition.xy;
+			fragmentPos = vertexPosition.xy;
+
+			fragmentColor = vertexColor;
+
+			fragmentUV = vec2(vertexUV.x, 1.0 - vertexUV.y);
+		})";
+
+	const char* SpriteBatch::DEPTH_FRAG_SRC = R"(#version 130
+
+		in vec2 fragmentPosition;
+		in vec4 fragmentColor;
+		in vec2 fragmentUV;
+
+		out vec4 color;
+
+		uniform sampler2D mySampler;
+
+		void main() {
+			vec4 textureColor = texture(mySampler, fragmentUV);
+
+			//opaque sprites write depth, their see-through texels must not
+			if (fragmentColor.a > 0.999 && textureColor.a < 0.5) {
+				discard;
+			}
+
+			color = fragmentColor * textureColor;
+		})";
+
+#pragma endregion // Shaders
+
+	GLuint SpriteBatch::s_quadIbo = 0;
+	size_t SpriteBatch::s_numQuadIndices = 0;
+	size_t SpriteBatch::s_numBatches = 0;
+
+	/// <summary>
+	///  To be able to draw bathces of textures
+	/// </summary>
+	SpriteBatch::SpriteBatch() : vbo(0), vao(0) {}
+
+	SpriteBatch::~SpriteBatch()
+	{
+		if (m_worker.valid()) {
+			m_worker.wait();
+		}
+	}
+
+	void SpriteBatch::init(VertexUpload upload /* VertexUpload::ORPHAN */, VertexFormat format /* VertexFormat::STANDARD */,
+		BatchProcessing processing /* = BatchProcessing::MAIN_THREAD */)
+	{
+		m_upload = upload;
+		m_format = format;
+		m_processing = processing;
+		if (m_upload == VertexUpload::STREAMING) {
+			m_streamBuffer.init(GL_ARRAY_BUFFER, (GLsizei)getVertexSize());
+		}
+		if (0 == vao) {
+			s_numBatches++;
+		}
+		createVertexArray();
+	}
+
+	void SpriteBatch::dispose()
+	{
+		// the worker may still be preparing a frame, nothing of it gets uploaded anymore
+		if (m_worker.valid()) {
+			m_worker.wait();
+		}
+		m_preparedSprites = nullptr;
+
+		if (0 == vao) { return; }
+
+		GLCall(glDeleteVertexArrays(1, &vao));
+		vao = 0;
+		if (vbo) {
+			GLCall(glDeleteBuffers(1, &vbo));
+			vbo = 0;
+		}
+		m_streamBuffer.dispose();
+		m_boundVbo = 0;
+		if (m_indirectBuffer) {
+			GLCall(glDeleteBuffers(1, &m_indirectBuffer));
+			m_indirectBuffer = 0;
+		}
+
+		if (--s_numBatches == 0 && s_quadIbo) {
+			GLCall(glDeleteBuffers(1, &s_quadIbo));
+			s_quadIbo = 0;
+			s_numQuadIndices = 0;
+		}
+	}
+
+	void SpriteBatch::begin(GlyphSortType sortBy /* GlyphSortType::TEXTURE */, const Camera2D* cullCamera /* = nullptr */)
+	{ /// to setup any state before rendering
+
+		// the worker may still be using the store, a frame that never got rendered is dropped
+		if (m_worker.valid()) {
+			m_worker.wait();
+		}
+		m_preparedSprites = nullptr;
+
+		// how to sort the sprites, VertexFormat::DEPTH makes its own keys in end()
+		sortType = m_format == VertexFormat::DEPTH ? GlyphSortType::TEXTURE : sortBy;
+
+		setCullCamera(cullCamera);
+		m_renderLayer = 0;
+		m_stats = SpriteBatchStats();
+
+		renderBatches.clear();
+		m_spriteTextures.clear();
+		m_spriteLayers.clear();
+		m_spriteStates.clear();
+		m_spriteDepths.clear();
+		m_states.clear();
+		m_lastState = 0;
+		m_keyBuilder.begin(sortType);
+		m_sortKeys.clear();
+		m_numSprites = 0;
+		m_rotatedSprites.clear();
+		m_rotatedRects.clear();
+		m_rotations.clear();
+		m_numSubmitBuffers = 0;
+	}
+
+	void SpriteBatch::setRenderLayer(uint8_t layer, const Camera2D* cullCamera /* = nullptr */)
+	{
+		m_renderLayer = layer;
+		setCullCamera(cullCamera);
+	}
+
+	void SpriteBatch::setCullCamera(const Camera2D* cullCamera)
+	{
+		m_cull = cullCamera != nullptr;
+		if (m_cull) {
+			m_cullRect = cullCamera->getViewRect();
+		}
+	}
+
+	void SpriteBatch::end()
+	{
+		// on this thread, the producers are done and merging may add render states
+		mergeSubmitBuffers();
+
+		if (m_processing == BatchProcessing::WORKER_THREAD) {
+			// everything but the upload, which needs the GL context of this thread
+			m_worker = std::async(std::launch::async, [this]() {
+				prepareFrame();
+				prepareRenderBatches();
+			});
+			return;
+		}
+
+		prepareFrame();
+		createRenderBatches();
+		reportStats();
+	}
+
+	void SpriteBatch::prepareFrame()
+	{
+		transformRotatedSprites();
+		// TEXTURE keys sort by texture name, the depth pass keys of opaque sprites too
+		m_keyBuilder.rankTextures(m_sortKeys);
+		if (m_format == VertexFormat::DEPTH) {
+			makeDepthPassKeys();
+		}
+		else if (sortType != GlyphSortType::NONE) {
+			makeLayerGroups();
+		}
+		sortGlyphs();
+	}
+
+	void SpriteBatch::finishWorker()
+	{
+		if (!m_worker.valid()) { return; }
+
+		// get() instead of wait(), so the worker's exceptions reach this thread
+		m_worker.get();
+		uploadPreparedSprites();
+		reportStats();
+	}
+
+	void SpriteBatch::reportStats()
+	{
+		FrameRenderStats& stats = RenderStats::current();
+		stats.culledSprites += m_stats.culledSprites;
+
+		if (sortType == GlyphSortType::NONE || m_numSprites == 0) { return; }
+		if (m_stats.fastSort) {
+			stats.fastSorts++;
+		}
+		else {
+			stats.fullSorts++;
+		}
+	}
+
+	void SpriteBatch::draw(const glm::vec4 & destRect,
+		const glm::vec4 & uvRect, GLuint m_texture, float depth, const ColorRGBA8 & color)
+	{
+		draw(destRect, uvRect, m_texture, depth, color, 0.f);
+	}
+
+	void SpriteBatch::draw(const glm::vec4 & destRect, const glm::vec4 & uvRect, GLuint m_texture, float depth, const ColorRGBA8 & color, float angle)
+	{
+		drawSprite(destRect, uvRect, m_texture, 0, getStateIndex(nullptr, BlendMode::CURRENT), depth, color, rotationFromAngle(angle));
+	}
+
+	void SpriteBatch::draw(const glm::vec4 & destRect, const glm::vec4 & uvRect, GLuint m_texture, float depth, const ColorRGBA8 & color, const glm::vec2& dir)
+	{
+		// rotationFromDir normalizes the direction into the (cos, sin) pair, a zero one draws unrotated
+		drawSprite(destRect, uvRect, m_texture, 0, getStateIndex(nullptr, BlendMode::CURRENT), depth, color, rotationFromDir(dir));
+	}
+
+	void SpriteBatch::draw(const glm::vec4 & destRect, const glm::vec4 & uvRect, const GLTexture & texture, float depth, const ColorRGBA8 & color, float angle /* = 0.f */)
+	{
+		drawSprite(destRect, texture.subUV(uvRect), texture.id, texture.layer, getStateIndex(nullptr, BlendMode::CURRENT), depth, color, rotationFromAngle(angle));
+	}
+
+	void SpriteBatch::draw(const glm::vec4 & destRect, const glm::vec4 & uvRect, const Material & material, float depth, const ColorRGBA8 & color, float angle /* = 0.f */)
+	{
+		drawSprite(destRect, uvRect, material.texture, 0, getStateIndex(material.program, material.blend), depth, color, rotationFromAngle(angle));
+	}
+
+	uint8_t SpriteBatch::getStateIndex(GLSLProgram* program, BlendMode blend)
+	{
+		if (m_lastState < m_states.size()) {
+			const RenderState& last = m_states[m_lastState];
+			if (last.program == program && last.blend == blend && last.renderLayer == m_renderLayer) { return m_lastState; }
+		}
+
+		// a handful of states per frame, a linear search is enough
+		for (size_t i = 0; i < m_states.size(); i++) {
+			const RenderState& state = m_states[i];
+			if (state.program == program && state.blend == blend && state.renderLayer == m_renderLayer) {
+				m_lastState = (uint8_t)i;
+				return m_lastState;
+			}
+		}
+
+		if (m_states.size() == MAX_RENDER_STATES) {
+			fatalError("SpriteBatch: more than " + std::to_string(MAX_RENDER_STATES) + " program, blend and layer combinations in one frame");
+		}
+
+		RenderState state;
+		state.program = program;
+		state.blend = blend;
+		state.renderLayer = m_renderLayer;
+		m_states.push_back(state);
+		m_lastState = (uint8_t)(m_states.size() - 1);
+		return m_lastState;
+	}
+
+	void SpriteBatch::drawSprite(const glm::vec4 & destRect, const glm::vec4 & uvRect, GLuint texture, GLuint layer, uint8_t state, float depth, const ColorRGBA8 & color, const glm::vec2& rotation)
+	{
+		if (m_cull && !isVisible(m_cullRect, destRect, rotation)) {
+			m_stats.culledSprites++;
+			return;
+		}
+		m_stats.keptSprites++;
+
+		if (m_format == VertexFormat::INSTANCED) {
+			// no vertex work at all, the shader does it
+			SpriteInstance* instance = addInstance(texture, state, depth);
+			instance->destRect = destRect;
+			instance->uvRect = uvRect;
+			instance->color = color;
+			instance->rotation = rotation;
+			return;
+		}
+
+		if (m_format == VertexFormat::LAYERED) {
+			m_spriteLayers.push_back(layer);
+		}
+
+		Vertex* quad = addQuad(texture, state, depth);
+		setQuadColorUV(quad, uvRect, color);
+
+		if (rotation.x == 1.f && rotation.y == 0.f) {
+			setQuadPositions(quad, destRect);
+			return;
+		}
+
+		// transformed together with the other rotated sprites in end()
+		m_rotatedSprites.push_back((uint32_t)(m_numSprites - 1));
+		m_rotatedRects.push_back(destRect);
+		m_rotations.push_back(rotation);
+	}
+
+	bool SpriteBatch::isVisible(const glm::vec4 & cullRect, const glm::vec4 & destRect, const glm::vec2 & rotation)
+	{
+		float minX = destRect.x, minY = destRect.y;
+		float maxX = destRect.x + destRect.z, maxY = destRect.y + destRect.w;
+
+		if (rotation.y != 0.f) {
+			// the circle around the center holds every rotation of the sprite
+			const float cx = destRect.x + destRect.z * 0.5f;
+			const float cy = destRect.y + destRect.w * 0.5f;
+			const float radius = 0.5f * std::sqrt(destRect.z * destRect.z + destRect.w * destRect.w);
+			minX = cx - radius; maxX = cx + radius;
+			minY = cy - radius; maxY = cy + radius;
+		}
+
+		return maxX >= cullRect.x && minX <= cullRect.x + cullRect.z &&
+			maxY >= cullRect.y && minY <= cullRect.y + cullRect.w;
+	}
+
+	void SpriteBatch::transformRotatedSprites()
+	{
+		const size_t count = m_rotatedSprites.size();
+		if (count == 0) { return; }
+
+		m_rotatedCorners.resize(count * 4);
+		transformQuads(m_rotatedRects.data(), m_rotations.data(), count, m_rotatedCorners.data());
+
+		for (size_t i = 0; i < count; i++) {
+			Vertex* quad = &m_quadVertices[m_rotatedSprites[i] * 4];
+			const glm::vec2* corners = &m_rotatedCorners[i * 4];
+			for (int k = 0; k < 4; k++) {
+				quad[k].setPos(corners[k].x, corners[k].y);
+			}
+		}
+	}
+
+	void SpriteBatch::drawMany(const SpriteInstance* sprites, size_t count, GLuint texture, float depth /* = 0.f */)
+	{
+		drawMany(sprites, count, Material(nullptr, texture, BlendMode::CURRENT), depth);
+	}
+
+	void SpriteBatch::drawMany(const SpriteInstance* sprites, size_t count, const Material& material, float depth /* = 0.f */)
+	{
+		appendSprites(sprites, count, material.texture, 0, getStateIndex(material.program, material.blend), depth);
+	}
+
+	void SpriteBatch::appendSprites(const SpriteInstance* sprites, size_t count, GLuint texture, GLuint layer, uint8_t state, float depth)
+	{
+		reserveSprites(count);
+
+		size_t s = m_numSprites;
+		for (size_t i = 0; i < count; i++) {
+			const SpriteInstance& sprite = sprites[i];
+			if (appendSprite(s, sprite.destRect, sprite.uvRect, sprite.color, sprite.rotation, layer)) {
+				s++;
+			}
+		}
+
+		commitSprites(s, texture, state, depth);
+	}
+
+	void SpriteBatch::drawMany(const glm::vec4* destRects, const glm::vec4* uvRects, const ColorRGBA8* colors, size_t count, GLuint texture, float depth /* = 0.f */)
+	{
+		const uint8_t state = getStateIndex(nullptr, BlendMode::CURRENT);
+		reserveSprites(count);
+
+		const glm::vec4 fullRect(0.f, 0.f, 1.f, 1.f);
+		const glm::vec2 noRotation(1.f, 0.f);
+
+		size_t s = m_numSprites;
+		for (size_t i = 0; i < count; i++) {
+			const glm::vec4& uvRect = uvRects ? uvRects[i] : fullRect;
+			if (appendSprite(s, destRects[i], uvRect, colors[i], noRotation, 0)) {
+				s++;
+			}
+		}
+
+		commitSprites(s, texture, state, depth);
+	}
+
+	size_t SpriteBatch::addSubmitBuffers(size_t count)
+	{
+		const size_t first = m_numSubmitBuffers;
+		m_numSubmitBuffers += count;
+		while (m_submitBuffers.size() < m_numSubmitBuffers) {
+			m_submitBuffers.emplace_back(new SpriteSubmitBuffer());
+		}
+
+		for (size_t i = first; i < m_numSubmitBuffers; i++) {
+			m_submitBuffers[i]->reset(m_renderLayer, m_cull, m_cullRect);
+		}
+		return first;
+	}
+
+	void SpriteBatch::mergeSubmitBuffers()
+	{
+		if (m_numSubmitBuffers == 0) { return; }
+
+		// the buffers already culled their sprites
+		const uint8_t renderLayer = m_renderLayer;
+		const bool cull = m_cull;
+		m_cull = false;
+
+		for (size_t b = 0; b < m_numSubmitBuffers; b++) {
+			const SpriteSubmitBuffer& buffer = *m_submitBuffers[b];
+			m_renderLayer = buffer.m_renderLayer;
+			m_stats.culledSprites += buffer.m_culledSprites;
+
+			size_t first = 0;
+			for (const SpriteSubmitBuffer::Run& run : buffer.m_runs) {
+				if (run.end == first) continue; // all of it culled
+
+				const uint8_t state = getStateIndex(run.material.program, run.material.blend);
+				appendSprites(&buffer.m_sprites[first], run.end - first, run.material.texture, run.layer, state, run.depth);
+				first = run.end;
+			}
+		}
+
+		m_renderLayer = renderLayer;
+		m_cull = cull;
+	}
+
+	void SpriteBatch::reserveSprites(size_t count)
+	{
+		const size_t needed = m_numSprites + count;
+
+		// same doubling as addQuad and addInstance
+		if (m_format == VertexFormat::INSTANCED) {
+			if (m_instances.size() < needed) {
+				m_instances.resize(needed * 2);
+			}
+		}
+		else if (m_quadVertices.size() < needed * 4) {
+			m_quadVertices.resize(needed * 4 * 2);
+		}
+
+		m_spriteTextures.reserve(needed);
+		m_spriteStates.reserve(needed);
+		if (sortType != GlyphSortType::NONE) {
+			m_sortKeys.reserve(needed);
+		}
+	}
+
+	bool SpriteBatch::appendSprite(size_t s, const glm::vec4 & destRect, const glm::vec4 & uvRect, const ColorRGBA8 & color, const glm::vec2 & rotation, GLuint layer)
+	{
+		if (m_cull && !isVisible(m_cullRect, destRect, rotation)) {
+			m_stats.culledSprites++;
+			return false;
+		}
+
+		if (m_format == VertexFormat::INSTANCED) {
+			SpriteInstance& instance = m_instances[s];
+			instance.destRect = destRect;
+			instance.uvRect = uvRect;
+			instance.color = color;
+			instance.rotation = rotation;
+			return true;
+		}
+
+		if (m_format == VertexFormat::LAYERED) {
+			m_spriteLayers.push_back(layer);
+		}
+
+		Vertex* quad = &m_quadVertices[s * 4];
+		setQuadColorUV(quad, uvRect, color);
+
+		if (rotation.x == 1.f && rotation.y == 0.f) {
+			setQuadPositions(quad, destRect);
+		}
+		else {
+			m_rotatedSprites.push_back((uint32_t)s);
+			m_rotatedRects.push_back(destRect);
+			m_rotations.push_back(rotation);
+		}
+		return true;
+	}
+
+	void SpriteBatch::commitSprites(size_t end, GLuint texture, uint8_t state, float depth)
+	{
+		m_spriteTextures.resize(end, texture);
+		m_spriteStates.resize(end, state);
+		if (m_format == VertexFormat::DEPTH) {
+			m_spriteDepths.resize(end, depth);
+		}
+
+		if (sortType != GlyphSortType::NONE) {
+			// every sprite has the same criteria, only the index differs
+			const uint64_t criteria = m_keyBuilder.makeKey(texture, state, depth, 0);
+			for (size_t s = m_numSprites; s < end; s++) {
+				m_sortKeys.push_back(criteria | (uint32_t)s);
+			}
+		}
+
+		m_stats.keptSprites += end - m_numSprites;
+		m_numSprites = end;
+	}
+
+	void SpriteBatch::addSprite(GLuint texture, uint8_t state, float depth)
+	{
+		if (sortType != GlyphSortType::NONE) {
+			m_sortKeys.push_back(m_keyBuilder.makeKey(texture, state, depth, (uint32_t)m_numSprites));
+		}
+		m_spriteTextures.push_back(texture);
+		m_spriteStates.push_back(state);
+		if (m_format == VertexFormat::DEPTH) {
+			m_spriteDepths.push_back(depth);
+		}
+	}
+
+	Vertex* SpriteBatch::addQuad(GLuint texture, uint8_t state, float depth)
+	{
+		addSprite(texture, state, depth);
+
+		// the store only ever grows, so draw() doesn't construct vertices it overwrites anyway
+		if (m_quadVertices.size() < (m_numSprites + 1) * 4) {
+			m_quadVertices.resize((m_numSprites + 1) * 4 * 2);
+		}
+
+		return &m_quadVertices[4 * m_numSprites++];
+	}
+
+	SpriteInstance* SpriteBatch::addInstance(GLuint texture, uint8_t state, float depth)
+	{
+		addSprite(texture, state, depth);
+
+		if (m_instances.size() < m_numSprites + 1) {
+			m_instances.resize((m_numSprites + 1) * 2);
+		}
+
+		return &m_instances[m_numSprites++];
+	}
+
+	void SpriteBatch::setQuad(Vertex* quad, const glm::vec4 & destRect, const glm::vec4 & uvRect, const ColorRGBA8 & color, float angle)
 	{
+		setQuadColorUV(quad, uvRect, color);
+
+		if (angle == 0.f) {
+			setQuadPositions(quad, destRect);
+			return;
+		}
+
+		glm::vec2 rotation = rotationFromAngle(angle);
+		glm::vec2 corners[4];
+		transformQuads(&destRect, &rotation, 1, corners);
+		for (int k = 0; k < 4; k++) {
+			quad[k].setPos(corners[k].x, corners[k].y);
+		}
+	}
+
+	void SpriteBatch::setQuadColorUV(Vertex* quad, const glm::vec4 & uvRect, const ColorRGBA8 & color)
+	{
+		Vertex& topLeft = quad[0];
+		Vertex& bottomLeft = quad[1];
+		Vertex& bottomRight = quad[2];
+		Vertex& topRight = quad[3];
+
 		topLeft.color = color;
-		topLeft.setPos(destRect.x, destRect.y + destRect.w);
 		topLeft.setUV(uvRect.x, uvRect.y + uvRect.w);
 
-		bottomLeft.color = color;
-		bottomLeft.setPos(destRect.x, destRect.y);
-		bottomLeft.setUV(uvRect.x, uvRect.y);
+		bottomLeft.color = color;
+		bottomLeft.setUV(uvRect.x, uvRect.y);
+
+		bottomRight.color = color;
+		bottomRight.setUV(uvRect.x + uvRect.z, uvRect.y);
+
+		topRight.color = color;
+		topRight.setUV(uvRect.x + uvRect.z, uvRect.y + uvRect.w);
+	}
+
+	void SpriteBatch::setQuadPositions(Vertex* quad, const glm::vec4 & destRect)
+	{
+		quad[0].setPos(destRect.x, destRect.y + destRect.w);
+		quad[1].setPos(destRect.x, destRect.y);
+		quad[2].setPos(destRect.x + destRect.z, destRect.y);
+		quad[3].setPos(destRect.x + destRect.z, destRect.y + destRect.w);
+	}
+
+	void SpriteBatch::encodeCompactVertex(const Vertex& vertex, const glm::vec2& origin, CompactVertex& out)
+	{
+		const float steps = (float)CompactVertex::POSITION_SUBSTEPS;
+		const float x = std::round((vertex.pos.x - origin.x) * steps);
+		const float y = std::round((vertex.pos.y - origin.y) * steps);
+		out.x = (GLshort)glm::clamp(x, -32768.f, 32767.f);
+		out.y = (GLshort)glm::clamp(y, -32768.f, 32767.f);
+
+		out.color = vertex.color;
+
+		out.u = (GLushort)(glm::clamp(vertex.uv.u, 0.f, 1.f) * 65535.f + 0.5f);
+		out.v = (GLushort)(glm::clamp(vertex.uv.v, 0.f, 1.f) * 65535.f + 0.5f);
+	}
+
+	void SpriteBatch::computeOrigin()
+	{
+		glm::vec2 minPos(m_quadVertices[0].pos.x, m_quadVertices[0].pos.y);
+		glm::vec2 maxPos = minPos;
+		for (size_t i = 1; i < m_numSprites * 4; i++) {
+			const Position& p = m_quadVertices[i].pos;
+			minPos = glm::min(minPos, glm::vec2(p.x, p.y));
+			maxPos = glm::max(maxPos, glm::vec2(p.x, p.y));
+		}
+
+		// whole units, so the origin itself adds no rounding
+		m_origin = glm::vec2(std::floor((minPos.x + maxPos.x) * 0.5f), std::floor((minPos.y + maxPos.y) * 0.5f));
+	}
+
+	size_t SpriteBatch::getVertexSize() const
+	{
+		switch (m_format) {
+		case VertexFormat::INSTANCED:
+			return sizeof(SpriteInstance);
+		case VertexFormat::LAYERED:
+			return sizeof(LayeredVertex);
+		case VertexFormat::COMPACT:
+			return sizeof(CompactVertex);
+		case VertexFormat::DEPTH:
+			return sizeof(DepthVertex);
+		default:
+			return sizeof(Vertex);
+		}
+	}
+
+	size_t SpriteBatch::getSpriteSize() const
+	{
+		return m_format == VertexFormat::INSTANCED ? sizeof(SpriteInstance) : 4 * getVertexSize();
+	}
+
+	void SpriteBatch::writeSprite(unsigned char* dest, size_t s) const
+	{
+		switch (m_format) {
+		case VertexFormat::INSTANCED:
+			std::memcpy(dest, &m_instances[s], sizeof(SpriteInstance));
+			break;
+		case VertexFormat::LAYERED: {
+			LayeredVertex* out = (LayeredVertex*)dest;
+			const Vertex* quad = &m_quadVertices[s * 4];
+			for (int v = 0; v < 4; v++) {
+				out[v].pos = quad[v].pos;
+				out[v].color = quad[v].color;
+				out[v].uv = quad[v].uv;
+				out[v].layer = m_spriteLayers[s];
+			}
+			break;
+		}
+		case VertexFormat::COMPACT: {
+			CompactVertex* out = (CompactVertex*)dest;
+			const Vertex* quad = &m_quadVertices[s * 4];
+			for (int v = 0; v < 4; v++) {
+				encodeCompactVertex(quad[v], m_origin, out[v]);
+			}
+			break;
+		}
+		case VertexFormat::DEPTH: {
+			DepthVertex* out = (DepthVertex*)dest;
+			const Vertex* quad = &m_quadVertices[s * 4];
+			for (int v = 0; v < 4; v++) {
+				out[v].pos = quad[v].pos;
+				out[v].depth = m_spriteDepths[s];
+				out[v].color = quad[v].color;
+				out[v].uv = quad[v].uv;
+			}
+			break;
+		}
+		default:
+			std::memcpy(dest, &m_quadVertices[s * 4], 4 * sizeof(Vertex));
+			break;
+		}
+	}
+
+	void SpriteBatch::renderBatch()
+	{
+		finishWorker();
+		drawBatches(false, 0);
+	}
+
+	void SpriteBatch::renderLayer(uint8_t layer)
+	{
+		finishWorker();
+		drawBatches(true, layer);
+	}
+
+	void SpriteBatch::drawBatches(bool oneLayer, uint8_t layer)
+	{
+		// binding vertex array object
+		GLCall(glBindVertexArray(vao));
+
+		const bool baseInstance = GLEW_ARB_base_instance != GL_FALSE;
+		const bool multiDrawIndirect = GLEW_ARB_multi_draw_indirect != GL_FALSE;
+		const GLenum textureTarget = m_format == VertexFormat::LAYERED ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+
+		if (m_format == VertexFormat::COMPACT) {
+			// attribute 3 has no array, every vertex reads this constant
+			GLCall(glVertexAttrib2f(3, m_origin.x, m_origin.y));
+		}
+
+		// only materials touch the program and blending, plain draws leave them to the caller
+		bool ownsState = false;
+		for (size_t i = 0; i < m_states.size(); i++) {
+			ownsState |= m_states[i].program != nullptr || m_states[i].blend != BlendMode::CURRENT;
+		}
+		// VertexFormat::DEPTH draws its opaque batches depth tested and written without blending,
+		// then the translucent ones depth tested only, with their usual blending
+		const bool depthPasses = m_format == VertexFormat::DEPTH;
+		BoundState bound;
+		if (ownsState || depthPasses) {
+			GLCall(glGetIntegerv(GL_CURRENT_PROGRAM, &bound.program));
+			bound.blend = glIsEnabled(GL_BLEND);
+			GLCall(glGetIntegerv(GL_BLEND_SRC_RGB, &bound.srcRGB));
+			GLCall(glGetIntegerv(GL_BLEND_DST_RGB, &bound.dstRGB));
+			GLCall(glGetIntegerv(GL_BLEND_SRC_ALPHA, &bound.srcAlpha));
+			GLCall(glGetIntegerv(GL_BLEND_DST_ALPHA, &bound.dstAlpha));
+		}
+		if (depthPasses) {
+			bound.depthTest = glIsEnabled(GL_DEPTH_TEST);
+			GLCall(glGetBooleanv(GL_DEPTH_WRITEMASK, &bound.depthWrite));
+			GLCall(glGetIntegerv(GL_DEPTH_FUNC, &bound.depthFunc));
+
+			// equal depths keep the draw order
+			GLCall(glEnable(GL_DEPTH_TEST));
+			GLCall(glDepthFunc(GL_LEQUAL));
+		}
+		int currentPass = -1; ///< 0 opaque, 1 translucent
+		GLuint currentState = (GLuint)MAX_RENDER_STATES;
+		size_t numStateChanges = 0;
+		size_t numDrawn = 0;
+		size_t numSprites = 0;
+		size_t numDrawCalls = 0;
+		size_t numTextureBinds = 0;
+		bool textureBound = false;
+		GLuint boundTexture = 0;
+
+		bool indirectBound = false;
+		if (m_format == VertexFormat::INSTANCED && baseInstance && multiDrawIndirect) {
+			indirectBound = uploadIndirectCommands();
+		}
+
+		// drawing runs of batches that share texture and state, a multi draw call per run
+		size_t i = 0;
+		while (i < renderBatches.size()) {
+			const RenderBatch& batch = renderBatches[i];
+			if (oneLayer && m_states[batch.m_state].renderLayer != layer) {
+				i++;
+				continue;
+			}
+
+			size_t runEnd = i + 1;
+			while (runEnd < renderBatches.size() && renderBatches[runEnd].m_texture == batch.m_texture &&
+				renderBatches[runEnd].m_state == batch.m_state && renderBatches[runEnd].m_translucent == batch.m_translucent) {
+				runEnd++;
+			}
+
+			bool blendChanged = false;
+			if (depthPasses && (int)batch.m_translucent != currentPass) {
+				currentPass = (int)batch.m_translucent;
+				GLCall(glDepthMask(batch.m_translucent ? GL_FALSE : GL_TRUE));
+				if (!ownsState) {
+					applyState(RenderState{ nullptr, BlendMode::CURRENT, 0 }, bound);
+				}
+				// the state's blending gets set again for the new pass
+				currentState = (GLuint)MAX_RENDER_STATES;
+				blendChanged = true;
+			}
 
-		bottomRight.color = color;
-		bottomRight.setPos(destRect.x + destRect.z, destRect.y);
-		bottomRight.setUV(uvRect.x + uvRect.z, uvRect.y);
+			// the sort keeps equal states together, so this happens once per state most of the time
+			if (ownsState && batch.m_state != currentState) {
+				applyState(m_states[batch.m_state], bound);
+				currentState = batch.m_state;
+				numStateChanges++;
+				blendChanged = true;
+			}
 
-		topRight.color = color;
-		topRight.setPos(destRect.x + destRect.z, destRect.y + destRect.w);
-		topRight.setUV(uvRect.x + uvRect.z, uvRect.y + uvRect.w);
-	}
+			if (blendChanged && depthPasses && !batch.m_translucent) {
+				GLCall(glDisable(GL_BLEND));
+			}
 
-	Glyph::Glyph(const glm::vec4 & destRect, const glm::vec4 & uvRect, GLuint m_texture, float depth, const ColorRGBA8 & color, float angle) :
-		m_texture(m_texture),
-		depth(depth)
-	{
-		glm::vec2 halfDims(destRect.z / 2.0f, destRect.w / 2.0f);
+			if (!textureBound || batch.m_texture != boundTexture) {
+				GLCall(glBindTexture(textureTarget, batch.m_texture));
+				textureBound = true;
+				boundTexture = batch.m_texture;
+				numTextureBinds++;
+			}
 
-		// Get points centered at origin
-		glm::vec2 tl(-halfDims.x, halfDims.y);
-		glm::vec2 bl(-halfDims.x, -halfDims.y);
-		glm::vec2 br(halfDims.x, -halfDims.y);
-		glm::vec2 tr(halfDims.x, halfDims.y);
+			numDrawCalls += drawRun(i, runEnd, baseInstance, multiDrawIndirect);
 
-		// Rotate the points
-		tl = rotatePoint(tl, angle) + halfDims;
-		bl = rotatePoint(bl, angle) + halfDims;
-		br = rotatePoint(br, angle) + halfDims;
-		tr = rotatePoint(tr, angle) + halfDims;
+			for (size_t b = i; b < runEnd; b++) {
+				numSprites += m_format == VertexFormat::INSTANCED ? renderBatches[b].numIndices : renderBatches[b].numIndices / 6;
+			}
+			numDrawn += runEnd - i;
+			i = runEnd;
+		}
 
-		topLeft.color = color;
-		topLeft.setPos(destRect.x + tl.x, destRect.y + tl.y);
-		topLeft.setUV(uvRect.x, uvRect.y + uvRect.w);
+		// unbinding the array objects
+		GLCall(glBindVertexArray(0));
+		if (indirectBound) {
+			GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0));
+		}
 
-		bottomLeft.color = color;
-		bottomLeft.setPos(destRect.x + bl.x, destRect.y + bl.y);
-		bottomLeft.setUV(uvRect.x, uvRect.y);
+		if (depthPasses) {
+			if (bound.depthTest) {
+				GLCall(glEnable(GL_DEPTH_TEST));
+			}
+			else {
+				GLCall(glDisable(GL_DEPTH_TEST));
+			}
+			GLCall(glDepthMask(bound.depthWrite));
+			GLCall(glDepthFunc(bound.depthFunc));
+		}
+		if (ownsState || depthPasses) {
+			restoreState(bound);
+		}
 
-		bottomRight.color = color;
-		bottomRight.setPos(destRect.x + br.x, destRect.y + br.y);
-		bottomRight.setUV(uvRect.x + uvRect.z, uvRect.y);
+		FrameRenderStats& stats = RenderStats::current();
+		stats.sprites += numSprites;
+		stats.renderBatches += numDrawn;
+		stats.drawCalls += numDrawCalls;
+		stats.textureBinds += numTextureBinds;
+		stats.stateChanges += numStateChanges;
 
-		topRight.color = color;
-		topRight.setPos(destRect.x + tr.x, destRect.y + tr.y);
-		topRight.setUV(uvRect.x + uvRect.z, uvRect.y + uvRect.w);
+		// the region can't be rewritten until these draws are done
+		if (m_upload == VertexUpload::STREAMING && numDrawn > 0) {
+			m_streamBuffer.fence();
+		}
 	}
 
-	glm::vec2 Glyph::rotatePoint(const glm::vec2& pos, float angle) {
-		glm::vec2 newVec;
-		newVec.x = pos.x * cos(angle) - pos.y * sin(angle);
-		newVec.y = pos.x * sin(angle) + pos.y * cos(angle);
-		return newVec;
-	}
+	size_t SpriteBatch::drawRun(size_t first, size_t end, bool baseInstance, bool multiDrawIndirect)
+	{
+		const GLsizei count = (GLsizei)(end - first);
 
-	/// <summary>
-	///  To be able to draw bathces of textures
-	/// </summary>
-	SpriteBatch::SpriteBatch() : vbo(0), vao(0) {}
+		if (m_format == VertexFormat::INSTANCED) {
+			if (count > 1 && baseInstance && multiDrawIndirect) {
+				// the commands of every batch are in m_indirectBuffer, in batch order
+				GLCall(glMultiDrawArraysIndirect(GL_TRIANGLE_STRIP,
+					(void *)(first * sizeof(DrawArraysIndirectCommand)), count, 0));
+				return 1;
+			}
 
-	SpriteBatch::~SpriteBatch() { }
+			for (size_t i = first; i < end; i++) {
+				const RenderBatch& batch = renderBatches[i];
+				GLuint firstInstance = m_firstVertex + batch.offset;
+				if (baseInstance) {
+					GLCall(glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, batch.numIndices, firstInstance));
+				}
+				else {
+					setInstanceAttribPointers(firstInstance);
+					GLCall(glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, batch.numIndices));
+				}
+			}
+			return count;
+		}
 
-	void SpriteBatch::init()
-	{
-		createVertexArray();
-	}
+		if (count == 1) {
+			const RenderBatch& batch = renderBatches[first];
+			GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, batch.numIndices, GL_UNSIGNED_INT,
+				(void *)(batch.offset * sizeof(GLuint)), m_firstVertex));
+			return 1;
+		}
 
-	void SpriteBatch::begin(GlyphSortType sortBy /* GlyphSortType::TEXTURE */)
-	{ /// to setup any state before rendering
+		m_multiCounts.resize(count);
+		m_multiOffsets.resize(count);
+		m_multiBaseVertices.assign(count, m_firstVertex);
+		for (GLsizei i = 0; i < count; i++) {
+			const RenderBatch& batch = renderBatches[first + i];
+			m_multiCounts[i] = batch.numIndices;
+			m_multiOffsets[i] = (void *)(batch.offset * sizeof(GLuint));
+		}
 
-		// how to sort the Glyphs
-		sortType = sortBy;
-		renderBatches.clear();
-		glyphs.clear();
+		GLCall(glMultiDrawElementsBaseVertex(GL_TRIANGLES, m_multiCounts.data(), GL_UNSIGNED_INT,
+			m_multiOffsets.data(), count, m_multiBaseVertices.data()));
+		return 1;
 	}
 
-	void SpriteBatch::end()
+	bool SpriteBatch::uploadIndirectCommands()
 	{
-		// resize and retarget
-		glyphPtrs.resize(glyphs.size());
-		for (size_t i = 0; i < glyphPtrs.size(); i++) {
-			glyphPtrs[i] = &glyphs[i];
+		// a single batch is drawn directly
+		if (renderBatches.size() < 2) { return false; }
+
+		m_indirectCommands.resize(renderBatches.size());
+		for (size_t i = 0; i < renderBatches.size(); i++) {
+			DrawArraysIndirectCommand& command = m_indirectCommands[i];
+			command.count = 4;
+			command.instanceCount = renderBatches[i].numIndices;
+			command.first = 0;
+			command.baseInstance = m_firstVertex + renderBatches[i].offset;
 		}
 
-		sortGlyphs();
-		createRenderBatches();
+		if (0 == m_indirectBuffer) {
+			GLCall(glGenBuffers(1, &m_indirectBuffer));
+		}
+
+		// stays bound for the draws, the indirect binding isn't part of the vao
+		const size_t size = m_indirectCommands.size() * sizeof(DrawArraysIndirectCommand);
+		GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer));
+		GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, size, nullptr, GL_STREAM_DRAW));
+		GLCall(glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, size, m_indirectCommands.data()));
+
+		RenderStats::current().bytesUploaded += size;
+		return true;
 	}
 
-	// TODO
-	void SpriteBatch::draw(const glm::vec4 & destRect,
-		const glm::vec4 & uvRect, GLuint m_texture, float depth, const ColorRGBA8 & color)
+	void SpriteBatch::applyState(const RenderState & state, const BoundState & bound)
+	{
+		// glUseProgram rather than GLSLProgram::use, the vao already has the right attributes enabled
+		const GLuint program = state.program ? state.program->getProgramID() : (GLuint)bound.program;
+		GLCall(glUseProgram(program));
+
+		switch (state.blend) {
+		case BlendMode::CURRENT:
+			if (bound.blend) {
+				GLCall(glEnable(GL_BLEND));
+			}
+			else {
+				GLCall(glDisable(GL_BLEND));
+			}
+			GLCall(glBlendFuncSeparate(bound.srcRGB, bound.dstRGB, bound.srcAlpha, bound.dstAlpha));
+			break;
+		case BlendMode::NONE:
+			GLCall(glDisable(GL_BLEND));
+			break;
+		case BlendMode::ALPHA:
+			GLCall(glEnable(GL_BLEND));
+			GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+			break;
+		case BlendMode::ADDITIVE:
+			GLCall(glEnable(GL_BLEND));
+			GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE));
+			break;
+		case BlendMode::PREMULTIPLIED:
+			GLCall(glEnable(GL_BLEND));
+			GLCall(glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA));
+			break;
+		}
+	}
+
+	void SpriteBatch::restoreState(const BoundState & bound)
 	{
-		glyphs.emplace_back(destRect, uvRect, m_texture, depth, color);
+		GLCall(glUseProgram((GLuint)bound.program));
+		if (bound.blend) {
+			GLCall(glEnable(GL_BLEND));
+		}
+		else {
+			GLCall(glDisable(GL_BLEND));
+		}
+		GLCall(glBlendFuncSeparate(bound.srcRGB, bound.dstRGB, bound.srcAlpha, bound.dstAlpha));
 	}
 
-	void SpriteBatch::draw(const glm::vec4 & destRect, const glm::vec4 & uvRect, GLuint m_texture, float depth, const ColorRGBA8 & color, float angle)
+	void SpriteBatch::createRenderBatches()
 	{
-		glyphs.emplace_back(destRect, uvRect, m_texture, depth, color, angle);
+		if (m_numSprites == 0) { return; }
+
+		if (m_format != VertexFormat::INSTANCED) {
+			reserveQuadIndices(m_numSprites);
+		}
+
+		const size_t uploadSize = m_numSprites * getSpriteSize();
+		const bool inPlace = useInPlace();
+
+		// the destination for the sprites, either GPU-visible memory
+		// or the staging buffer that gets uploaded afterwards
+		unsigned char* dest = nullptr;
+		if (m_upload == VertexUpload::STREAMING) {
+			dest = (unsigned char*)m_streamBuffer.map(uploadSize);
+
+			// the ring buffer may have been reallocated
+			if (m_streamBuffer.getId() != m_boundVbo) {
+				createVertexArray();
+			}
+			m_firstVertex = (GLint)(m_streamBuffer.getOffset() / getVertexSize());
+		}
+		else if (inPlace && storeIsUploadLayout()) {
+			// the store itself gets uploaded
+			dest = m_format == VertexFormat::INSTANCED ?
+				(unsigned char*)m_instances.data() : (unsigned char*)m_quadVertices.data();
+			m_firstVertex = 0;
+		}
+		else {
+			// alocating all the memory we need for all
+			// the sprites, the capacity is kept between frames
+			m_staging.resize(uploadSize);
+			dest = m_staging.data();
+			m_firstVertex = 0;
+		}
+
+		buildRenderBatches(dest, inPlace);
+
+		RenderStats::current().bytesUploaded += uploadSize;
+
+		if (m_upload == VertexUpload::STREAMING) {
+			// the sprites are already in place
+			m_streamBuffer.unmap();
+			return;
+		}
+
+		GLCall(glBindBuffer(GL_ARRAY_BUFFER, vbo));
+
+		// orphan the buffer
+		GLCall(glBufferData(GL_ARRAY_BUFFER, uploadSize, nullptr, GL_DYNAMIC_DRAW));
+		// uploading the data
+		GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, uploadSize, dest));
+		// unbinding the buffer
+		GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
 	}
 
-	void SpriteBatch::draw(const glm::vec4 & destRect, const glm::vec4 & uvRect, GLuint m_texture, float depth, const ColorRGBA8 & color, const glm::vec2& dir)
+	void SpriteBatch::prepareRenderBatches()
 	{
-		// determining angle from direction
-		const glm::vec2 right(1.f, 0.f);
-		float angle = acos(glm::dot(right, dir));
-		if (dir.y < 0.f)  angle = -angle;
+		if (m_numSprites == 0) { return; }
+
+		const bool inPlace = useInPlace();
 
-		glyphs.emplace_back(destRect, uvRect, m_texture, depth, color, angle);
+		// no GL here, the sprites wait in memory for uploadPreparedSprites
+		unsigned char* dest = nullptr;
+		if (inPlace && storeIsUploadLayout()) {
+			dest = m_format == VertexFormat::INSTANCED ?
+				(unsigned char*)m_instances.data() : (unsigned char*)m_quadVertices.data();
+		}
+		else {
+			m_staging.resize(m_numSprites * getSpriteSize());
+			dest = m_staging.data();
+		}
+
+		buildRenderBatches(dest, inPlace);
+		m_preparedSprites = dest;
 	}
 
-	void SpriteBatch::renderBatch()
+	void SpriteBatch::uploadPreparedSprites()
 	{
-		// binding vertex array object
-		GLCall(glBindVertexArray(vao));
+		if (!m_preparedSprites) { return; }
 
-		// drawing each batch
-		for (size_t i = 0; i < renderBatches.size(); i++) {
-			GLCall(glBindTexture(GL_TEXTURE_2D, renderBatches[i].m_texture));
+		if (m_format != VertexFormat::INSTANCED) {
+			reserveQuadIndices(m_numSprites);
+		}
 
-			GLCall(glDrawArrays(GL_TRIANGLES, renderBatches[i].offset, renderBatches[i].numVertices));
+		const size_t uploadSize = m_numSprites * getSpriteSize();
+		RenderStats::current().bytesUploaded += uploadSize;
+
+		if (m_upload == VertexUpload::STREAMING) {
+			void* dest = m_streamBuffer.map(uploadSize);
+			if (m_streamBuffer.getId() != m_boundVbo) {
+				createVertexArray();
+			}
+			m_firstVertex = (GLint)(m_streamBuffer.getOffset() / getVertexSize());
+
+			std::memcpy(dest, m_preparedSprites, uploadSize);
+			m_streamBuffer.unmap();
 		}
+		else {
+			m_firstVertex = 0;
 
-		// unbinding the array objects
-		GLCall(glBindVertexArray(0));
+			GLCall(glBindBuffer(GL_ARRAY_BUFFER, vbo));
+			GLCall(glBufferData(GL_ARRAY_BUFFER, uploadSize, nullptr, GL_DYNAMIC_DRAW));
+			GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, uploadSize, m_preparedSprites));
+			GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+		}
+
+		// rendering the same frame again doesn't upload it again
+		m_preparedSprites = nullptr;
 	}
 
-	void SpriteBatch::createRenderBatches()
+	bool SpriteBatch::useInPlace() const
 	{
-		if (glyphs.empty()) { return; }
+		// sorted sprites in long submission order runs are uploaded as they are, and drawn
+		// as ranges of the store, consecutive ranges sharing texture and state go out in one
+		// multi draw call. Otherwise they are copied into draw order, one range per batch
+		return sortType == GlyphSortType::NONE || countSortedRanges() * MIN_SPRITES_PER_RANGE <= m_numSprites;
+	}
+
+	void SpriteBatch::buildRenderBatches(unsigned char* dest, bool inPlace)
+	{
+		const bool sorted = sortType != GlyphSortType::NONE;
+		const bool depthPasses = m_format == VertexFormat::DEPTH;
 
-		// vertex array to be uploaded to vbo
-		// alocating all the memory we need for all
-		// vertices for the glyphs
-		// this means it can be treated as an array
-		// and this is a lot faster than push back new item every time
-		std::vector <Vertex> vertices;
-		vertices.resize(glyphs.size() * 6);
+		// instances are drawn one per sprite, quads take 6 indices
+		// of the shared index buffer for their 4 vertices
+		const GLuint perSprite = m_format == VertexFormat::INSTANCED ? 1 : 6;
+		const size_t spriteSize = getSpriteSize();
 
-		int offset = 0;
-		int cv = 0; // current vertex
+		if (m_format == VertexFormat::COMPACT) {
+			computeOrigin();
+		}
 
-		// storing the first batch
-		renderBatches.emplace_back(offset, 6, glyphPtrs[0]->m_texture);
-		offset += 6;
+		GLuint offset = 0;
 
-		vertices[cv++] = glyphPtrs[0]->topLeft;
-		vertices[cv++] = glyphPtrs[0]->bottomLeft;
-		vertices[cv++] = glyphPtrs[0]->bottomRight;
-		vertices[cv++] = glyphPtrs[0]->bottomRight;
-		vertices[cv++] = glyphPtrs[0]->topRight;
-		vertices[cv++] = glyphPtrs[0]->topLeft;
+		for (size_t i = 0; i < m_numSprites; i++) {
+			// the low word of the key is the sprite index
+			const size_t s = sorted ? (uint32_t)m_sortKeys[i] : i;
+			const GLuint texture = m_spriteTextures[s];
+			const GLuint state = m_spriteStates[s];
+			// in place, the sprite is drawn from where it is in the store
+			const GLuint spriteOffset = inPlace ? (GLuint)(s * perSprite) : offset;
+			const bool translucent = depthPasses && isTranslucent(s);
 
-		// setting the rest of the batches
-		for (size_t cg = 1; cg < glyphPtrs.size(); cg++) {
-			if (glyphPtrs[cg]->m_texture != glyphPtrs[cg - 1]->m_texture) {
-				renderBatches.emplace_back(offset, 6, glyphPtrs[cg]->m_texture);
+			// a new batch for every texture, state or pass switch, and for every gap in place
+			const RenderBatch* last = renderBatches.empty() ? nullptr : &renderBatches.back();
+			if (!last || texture != last->m_texture || state != last->m_state ||
+				translucent != last->m_translucent || spriteOffset != last->offset + last->numIndices) {
+				renderBatches.emplace_back(spriteOffset, perSprite, texture, state);
+				renderBatches.back().m_translucent = translucent;
 			}
 			else {
-				renderBatches.back().numVertices += 6;
+				renderBatches.back().numIndices += perSprite;
+			}
+			offset += perSprite;
+
+			if (!inPlace) {
+				writeSprite(dest + i * spriteSize, s);
 			}
-			vertices[cv++] = glyphPtrs[cg]->topLeft;
-			vertices[cv++] = glyphPtrs[cg]->bottomLeft;
-			vertices[cv++] = glyphPtrs[cg]->bottomRight;
-			vertices[cv++] = glyphPtrs[cg]->bottomRight;
-			vertices[cv++] = glyphPtrs[cg]->topRight;
-			vertices[cv++] = glyphPtrs[cg]->topLeft;
-			offset += 6;
 		}
 
-		GLCall(glBindBuffer(GL_ARRAY_BUFFER, vbo));
+		if (!inPlace) { return; }
 
-		// orphan the buffer
-		GLCall(glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW));
-		// uploading the data
-		GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Vertex), vertices.data()));
-		// unbinding the buffer
-		GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+		if (!storeIsUploadLayout()) {
+			for (size_t s = 0; s < m_numSprites; s++) {
+				writeSprite(dest + s * spriteSize, s);
+			}
+			return;
+		}
+
+		const unsigned char* store = m_format == VertexFormat::INSTANCED ?
+			(const unsigned char*)m_instances.data() : (const unsigned char*)m_quadVertices.data();
+		if (dest != store) {
+			std::memcpy(dest, store, m_numSprites * spriteSize);
+		}
 	}
 	void SpriteBatch::createVertexArray()
 	{
@@ -197,10 +1260,95 @@ namespace ge {
 		}
 		GLCall(glBindVertexArray(vao));
 
-		if (0 == vbo) {
-			GLCall(glGenBuffers(1, &vbo));
+		if (0 == s_quadIbo) {
+			GLCall(glGenBuffers(1, &s_quadIbo));
+		}
+
+		if (m_upload == VertexUpload::STREAMING) {
+			// nothing to point to until the first map() allocates the ring buffer
+			if (0 == m_streamBuffer.getId()) {
+				GLCall(glBindVertexArray(0));
+				return;
+			}
+			m_boundVbo = m_streamBuffer.getId();
+		}
+		else {
+			if (0 == vbo) {
+				GLCall(glGenBuffers(1, &vbo));
+			}
+			m_boundVbo = vbo;
+		}
+		GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_boundVbo));
+
+		setVertexAttribPointers();
+
+		// the element buffer binding is part of the vao state
+		GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_quadIbo));
+
+		// unbinding and disableing vao and vbo
+		GLCall(glBindVertexArray(0));
+		GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+	}
+	void SpriteBatch::setVertexAttribPointers()
+	{
+		if (m_format == VertexFormat::INSTANCED) {
+			for (GLuint i = 0; i < 4; i++) {
+				GLCall(glEnableVertexAttribArray(i));
+				// advancing once per instance instead of once per vertex
+				GLCall(glVertexAttribDivisor(i, 1));
+			}
+			setInstanceAttribPointers(0);
+			return;
+		}
+
+		if (m_format == VertexFormat::LAYERED) {
+			GLCall(glEnableVertexAttribArray(0));
+			GLCall(glEnableVertexAttribArray(1));
+			GLCall(glEnableVertexAttribArray(2));
+			GLCall(glEnableVertexAttribArray(3));
+
+			GLCall(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE,
+				sizeof(LayeredVertex), (void *)offsetof(LayeredVertex, pos)));
+			GLCall(glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE,
+				sizeof(LayeredVertex), (void *)offsetof(LayeredVertex, color)));
+			GLCall(glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE,
+				sizeof(LayeredVertex), (void *)offsetof(LayeredVertex, uv)));
+			// the layer reaches the shader as a float, as texture() wants it
+			GLCall(glVertexAttribPointer(3, 1, GL_UNSIGNED_INT, GL_FALSE,
+				sizeof(LayeredVertex), (void *)offsetof(LayeredVertex, layer)));
+			return;
+		}
+
+		if (m_format == VertexFormat::DEPTH) {
+			GLCall(glEnableVertexAttribArray(0));
+			GLCall(glEnableVertexAttribArray(1));
+			GLCall(glEnableVertexAttribArray(2));
+
+			// position and depth read as one vec3
+			GLCall(glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
+				sizeof(DepthVertex), (void *)offsetof(DepthVertex, pos)));
+			GLCall(glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE,
+				sizeof(DepthVertex), (void *)offsetof(DepthVertex, color)));
+			GLCall(glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE,
+				sizeof(DepthVertex), (void *)offsetof(DepthVertex, uv)));
+			return;
+		}
+
+		if (m_format == VertexFormat::COMPACT) {
+			GLCall(glEnableVertexAttribArray(0));
+			GLCall(glEnableVertexAttribArray(1));
+			GLCall(glEnableVertexAttribArray(2));
+
+			// fixed point offsets, scaled by the shader
+			GLCall(glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE,
+				sizeof(CompactVertex), (void *)offsetof(CompactVertex, x)));
+			GLCall(glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE,
+				sizeof(CompactVertex), (void *)offsetof(CompactVertex, color)));
+			// 0..65535 read as 0..1
+			GLCall(glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_TRUE,
+				sizeof(CompactVertex), (void *)offsetof(CompactVertex, u)));
+			return;
 		}
-		GLCall(glBindBuffer(GL_ARRAY_BUFFER, vbo));
 
 		// Telling OpenGL what kind of attributes we're sending
 		GLCall(glEnableVertexAttribArray(0));
@@ -219,27 +1367,297 @@ namespace ge {
 		// this is the UV attribute pointer
 		GLCall(glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE,
 			sizeof(Vertex), (void *)offsetof(Vertex, uv)));
+	}
+	void SpriteBatch::setInstanceAttribPointers(GLuint firstInstance)
+	{
+		// expects the vao to be bound, the buffer is taken from m_boundVbo
+		GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_boundVbo));
 
-		// unbinding and disableing vao and vbo
+		const size_t base = firstInstance * sizeof(SpriteInstance);
+
+		GLCall(glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE,
+			sizeof(SpriteInstance), (void *)(base + offsetof(SpriteInstance, destRect))));
+
+		GLCall(glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE,
+			sizeof(SpriteInstance), (void *)(base + offsetof(SpriteInstance, uvRect))));
+
+		GLCall(glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE,
+			sizeof(SpriteInstance), (void *)(base + offsetof(SpriteInstance, color))));
+
+		GLCall(glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE,
+			sizeof(SpriteInstance), (void *)(base + offsetof(SpriteInstance, rotation))));
+	}
+	void SpriteBatch::reserveQuadIndices(size_t numQuads)
+	{
+		if (numQuads <= s_numQuadIndices) { return; }
+
+		// growing at least twice, so it settles after a few frames
+		size_t newCapacity = s_numQuadIndices * 2;
+		if (newCapacity < numQuads) newCapacity = numQuads;
+
+		std::vector<GLuint> indices(newCapacity * 6);
+		for (size_t q = 0; q < newCapacity; q++) {
+			GLuint v = (GLuint)(q * 4);
+			// topLeft, bottomLeft, bottomRight
+			indices[q * 6 + 0] = v + 0;
+			indices[q * 6 + 1] = v + 1;
+			indices[q * 6 + 2] = v + 2;
+			// bottomRight, topRight, topLeft
+			indices[q * 6 + 3] = v + 2;
+			indices[q * 6 + 4] = v + 3;
+			indices[q * 6 + 5] = v + 0;
+		}
+
+		// binding with no vao, so no vao's element buffer gets replaced
 		GLCall(glBindVertexArray(0));
+		GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_quadIbo));
+		GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW));
+		GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+
+		s_numQuadIndices = newCapacity;
+		RenderStats::current().bytesUploaded += indices.size() * sizeof(GLuint);
+	}
+
+	size_t SpriteBatch::countSortedRanges() const
+	{
+		size_t numRanges = 0;
+		for (size_t i = 0; i < m_numSprites; i++) {
+			const uint32_t s = (uint32_t)m_sortKeys[i];
+			if (i == 0) {
+				numRanges++;
+				continue;
+			}
+			const uint32_t prev = (uint32_t)m_sortKeys[i - 1];
+			if (s != prev + 1 || m_spriteTextures[s] != m_spriteTextures[prev] || m_spriteStates[s] != m_spriteStates[prev]) {
+				numRanges++;
+			}
+		}
+		return numRanges;
+	}
+
+	bool SpriteBatch::isTranslucent(size_t s) const
+	{
+		switch (m_states[m_spriteStates[s]].blend) {
+		case BlendMode::NONE:
+			return false;
+		case BlendMode::ADDITIVE:
+		case BlendMode::PREMULTIPLIED:
+			return true;
+		default:
+			// every vertex of the quad has the same color
+			return m_quadVertices[s * 4].color.a != 255;
+		}
+	}
+
+	void SpriteBatch::makeDepthPassKeys()
+	{
+		// the render layer, then the pass, go in the groups
+		m_sortGroups.resize(m_numSprites);
+
+		// the keys are still in submission order, key s is sprite s
+		for (size_t s = 0; s < m_numSprites; s++) {
+			const bool translucent = isTranslucent(s);
+			m_sortGroups[s] = (uint16_t)(((uint32_t)m_states[m_spriteStates[s]].renderLayer << 1) | (translucent ? 1 : 0));
+
+			// the depth test orders opaque sprites, they keep their TEXTURE key and are only grouped
+			if (translucent) {
+				m_sortKeys[s] = ((uint64_t)~floatToSortable(m_spriteDepths[s]) << 32) | (uint32_t)s;
+			}
+		}
+	}
+
+	void SpriteBatch::makeLayerGroups()
+	{
+		m_sortGroups.clear();
+
+		bool oneLayer = true;
+		for (size_t i = 1; i < m_states.size() && oneLayer; i++) {
+			oneLayer = m_states[i].renderLayer == m_states[0].renderLayer;
+		}
+		if (oneLayer) { return; }
+
+		m_sortGroups.resize(m_numSprites);
+		for (size_t s = 0; s < m_numSprites; s++) {
+			m_sortGroups[s] = m_states[m_spriteStates[s]].renderLayer;
+		}
+	}
+
+	void SpriteBatch::groupKeys()
+	{
+		if (m_sortGroups.empty()) { return; }
+
+		const size_t n = m_sortKeys.size();
+		m_groupOffsets.assign(MAX_SORT_GROUPS + 1, 0);
+		for (size_t i = 0; i < n; i++) {
+			m_groupOffsets[m_sortGroups[(uint32_t)m_sortKeys[i]] + 1]++;
+		}
+
+		for (size_t g = 0; g < MAX_SORT_GROUPS; g++) {
+			// all in one group, the keys are already in order
+			if (m_groupOffsets[g + 1] == n) { return; }
+			m_groupOffsets[g + 1] += m_groupOffsets[g];
+		}
+
+		m_sortScratch.resize(n);
+		for (size_t i = 0; i < n; i++) {
+			const uint16_t group = m_sortGroups[(uint32_t)m_sortKeys[i]];
+			m_sortScratch[m_groupOffsets[group]++] = m_sortKeys[i];
+		}
+		m_sortKeys.swap(m_sortScratch);
 	}
+
 	void SpriteBatch::sortGlyphs()
 	{
-		switch (sortType) {
-		case ge::GlyphSortType::FRONT_TO_BACK:
-			std::stable_sort(glyphPtrs.begin(), glyphPtrs.end(),
-				[](Glyph* a, Glyph* b) {return a->depth < b->depth; });
-			break;
-		case ge::GlyphSortType::BACK_TO_FRONT:
-			std::stable_sort(glyphPtrs.begin(), glyphPtrs.end(),
-				[](Glyph* a, Glyph* b) {return a->depth > b->depth; });
-			break;
-		case ge::GlyphSortType::TEXTURE:
-			std::stable_sort(glyphPtrs.begin(), glyphPtrs.end(),
-				[](Glyph* a, Glyph* b) {return a->m_texture < b->m_texture; });
-			break;
+		// draw order is already the submission order
+		if (sortType == GlyphSortType::NONE) { return; }
+
+		// up to this many runs merging beats the radix sort
+		const size_t MAX_RUNS = 16;
+
+		bool reused = false;
+		bool fast = mergeSortedRuns(m_sortKeys, m_sortScratch, 1);
+		if (!fast) {
+			reused = reuseLastOrder();
+			fast = reused || mergeSortedRuns(m_sortKeys, m_sortScratch, MAX_RUNS);
+		}
+
+		if (!fast) {
+			// the submission index in the low word is already ascending,
+			// so only the high word needs sorting, and stability is kept
+			radixSort(m_sortKeys, m_sortScratch, 4);
+		}
+
+		// last frame's order already has the groups first
+		if (!reused) {
+			groupKeys();
+		}
+
+		// remembering the order for the next frame, unless it is the submission order
+		bool inSubmissionOrder = true;
+		for (size_t i = 0; i < m_sortKeys.size() && inSubmissionOrder; i++) {
+			inSubmissionOrder = (uint32_t)m_sortKeys[i] == i;
+		}
+		if (inSubmissionOrder) {
+			m_lastOrder.clear();
+		}
+		else {
+			m_lastOrder.resize(m_sortKeys.size());
+			for (size_t i = 0; i < m_sortKeys.size(); i++) {
+				m_lastOrder[i] = (uint32_t)m_sortKeys[i];
+			}
+		}
+
+		m_stats.fastSort = fast;
+		if (fast) {
+			m_numFastSortFrames++;
+		}
+	}
+
+	bool SpriteBatch::reuseLastOrder()
+	{
+		const size_t n = m_sortKeys.size();
+		if (m_lastOrder.size() != n) { return false; }
+
+		// the keys are still in submission order, so key i belongs to sprite i
+		m_sortScratch.resize(n);
+		for (size_t i = 0; i < n; i++) {
+			m_sortScratch[i] = m_sortKeys[m_lastOrder[i]];
+			if (i == 0) continue;
+
+			// ordered by group first, then by key
+			const uint16_t group = getSortGroup(m_lastOrder[i]);
+			const uint16_t prevGroup = getSortGroup(m_lastOrder[i - 1]);
+			if (group < prevGroup || (group == prevGroup && m_sortScratch[i] < m_sortScratch[i - 1])) { return false; }
+		}
+
+		m_sortKeys.swap(m_sortScratch);
+		return true;
+	}
+
+
+#pragma region SpriteSubmitBuffer
+
+	void SpriteSubmitBuffer::draw(const glm::vec4 & destRect, const glm::vec4 & uvRect, GLuint texture, float depth, const ColorRGBA8 & color, float angle /* = 0.f */)
+	{
+		useRun(Material(nullptr, texture, BlendMode::CURRENT), 0, depth);
+		addSprite(destRect, uvRect, color, rotationFromAngle(angle));
+	}
+
+	void SpriteSubmitBuffer::draw(const glm::vec4 & destRect, const glm::vec4 & uvRect, const GLTexture & texture, float depth, const ColorRGBA8 & color, float angle /* = 0.f */)
+	{
+		useRun(Material(nullptr, texture.id, BlendMode::CURRENT), texture.layer, depth);
+		addSprite(destRect, texture.subUV(uvRect), color, rotationFromAngle(angle));
+	}
+
+	void SpriteSubmitBuffer::draw(const glm::vec4 & destRect, const glm::vec4 & uvRect, const Material & material, float depth, const ColorRGBA8 & color, float angle /* = 0.f */)
+	{
+		useRun(material, 0, depth);
+		addSprite(destRect, uvRect, color, rotationFromAngle(angle));
+	}
+
+	void SpriteSubmitBuffer::drawMany(const SpriteInstance* sprites, size_t count, GLuint texture, float depth /* = 0.f */)
+	{
+		drawMany(sprites, count, Material(nullptr, texture, BlendMode::CURRENT), depth);
+	}
+
+	void SpriteSubmitBuffer::drawMany(const SpriteInstance* sprites, size_t count, const Material & material, float depth /* = 0.f */)
+	{
+		useRun(material, 0, depth);
+		m_sprites.reserve(m_sprites.size() + count);
+		for (size_t i = 0; i < count; i++) {
+			addSprite(sprites[i].destRect, sprites[i].uvRect, sprites[i].color, sprites[i].rotation);
+		}
+	}
+
+	void SpriteSubmitBuffer::reset(uint8_t renderLayer, bool cull, const glm::vec4 & cullRect)
+	{
+		m_sprites.clear();
+		m_runs.clear();
+		m_renderLayer = renderLayer;
+		m_cull = cull;
+		m_cullRect = cullRect;
+		m_culledSprites = 0;
+	}
+
+	void SpriteSubmitBuffer::useRun(const Material & material, GLuint layer, float depth)
+	{
+		if (!m_runs.empty()) {
+			Run& last = m_runs.back();
+			if (last.material.program == material.program && last.material.texture == material.texture &&
+				last.material.blend == material.blend && last.layer == layer && last.depth == depth) {
+				return;
+			}
+			// nothing was kept since it started, reuse it
+			const size_t lastBegin = m_runs.size() > 1 ? m_runs[m_runs.size() - 2].end : 0;
+			if (last.end == lastBegin) {
+				m_runs.pop_back();
+			}
+		}
+
+		Run run;
+		run.material = material;
+		run.layer = layer;
+		run.depth = depth;
+		run.end = m_sprites.size();
+		m_runs.push_back(run);
+	}
+
+	void SpriteSubmitBuffer::addSprite(const glm::vec4 & destRect, const glm::vec4 & uvRect, const ColorRGBA8 & color, const glm::vec2 & rotation)
+	{
+		if (m_cull && !SpriteBatch::isVisible(m_cullRect, destRect, rotation)) {
+			m_culledSprites++;
+			return;
 		}
 
+		SpriteInstance sprite;
+		sprite.destRect = destRect;
+		sprite.uvRect = uvRect;
+		sprite.color = color;
+		sprite.rotation = rotation;
+		m_sprites.push_back(sprite);
+		m_runs.back().end = m_sprites.size();
 	}
 
+#pragma endregion // SpriteSubmitBuffer
+
 } //namespace ge
@@ -2,41 +2,138 @@
 
 #include <glm/glm.hpp>
 #include <vector>
+#include <cstdint>
+#include <future>
+#include <memory>
 #include <GL\glew.h>
 #include "Vertex.h"
+#include "GLTexture.h"
+#include "StreamBuffer.h"
+#include "SpriteSortKeys.h"
 
 namespace ge {
 
-	enum class GlyphSortType {
-		NONE,
-		FRONT_TO_BACK,
-		BACK_TO_FRONT,
-		TEXTURE
+	/// How the vertices are sent to the GPU on end()
+	enum class VertexUpload {
+		ORPHAN,		///< glBufferData(nullptr) + glBufferSubData into a single vbo
+		STREAMING	///< written straight into a triple-buffered mapped ring buffer
 	};
 
-	class Glyph {
-	public:
-		Glyph() {};
-		Glyph(const glm::vec4 & destRect, const glm::vec4 & uvRect, GLuint m_texture, float depth, const ColorRGBA8 & color);
-		
-		Glyph(const glm::vec4 & destRect, const glm::vec4 & uvRect, GLuint m_texture, float depth, const ColorRGBA8 & color, float angle);
+	/// What a sprite looks like on the GPU
+	enum class VertexFormat {
+		STANDARD,	///< 4 ge::Vertex per sprite, works with any vertexPosition/vertexColor/vertexUV shader
+		INSTANCED,	///< 1 SpriteInstance per sprite, needs SpriteBatch::INSTANCED_VERT_SRC
+		LAYERED,	///< 4 ge::LayeredVertex per sprite, textures are GL_TEXTURE_2D_ARRAY layers,
+					///< needs SpriteBatch::LAYERED_VERT_SRC and LAYERED_FRAG_SRC
+		COMPACT,	///< 4 ge::CompactVertex (12 bytes instead of 20) per sprite, see its precision limits,
+					///< needs SpriteBatch::COMPACT_VERT_SRC
+		DEPTH		///< 4 ge::DepthVertex per sprite, the sprite depth becomes the vertex z. Opaque sprites are drawn
+					///< unsorted by texture with depth test and write, translucent ones after them back to front.
+					///< Replaces the sort type of begin(), needs SpriteBatch::DEPTH_VERT_SRC and DEPTH_FRAG_SRC
+	};
 
-		GLuint m_texture;
-		float depth;
+	/// Where end() sorts the sprites and writes their vertices
+	enum class BatchProcessing {
+		MAIN_THREAD,	///< in end()
+		WORKER_THREAD	///< on a worker thread started by end(), the next renderBatch() waits for it and uploads.
+						///< Draw into the batch again only after begin(), see DoubleBufferedSpriteBatch
+	};
 
-		Vertex topLeft, bottomLeft, topRight, bottomRight;
-	private:
-		// Rotates a point about (0,0) by angle
-		glm::vec2 rotatePoint(const glm::vec2& pos, float angle);
+	/// Per-instance record of VertexFormat::INSTANCED, the quad is expanded in the vertex shader.
+	/// 44 bytes, uploaded as it is, its layout is the instance attribute stride
+	struct SpriteInstance {
+		glm::vec4 destRect;
+		glm::vec4 uvRect;
+		ColorRGBA8 color;
+		glm::vec2 rotation; ///< (cos, sin) of the angle
+	};
+	static_assert(sizeof(SpriteInstance) == 44, "SpriteInstance must stay packed, the instance attributes point into it");
+
+	class Camera2D;
+	class GLSLProgram;
+
+	/// How the sprites of a Material are blended with what is behind them
+	enum class BlendMode {
+		CURRENT,	///< whatever blending is set when renderBatch() is called
+		NONE,
+		ALPHA,		///< GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA
+		ADDITIVE,	///< GL_SRC_ALPHA, GL_ONE
+		PREMULTIPLIED	///< GL_ONE, GL_ONE_MINUS_SRC_ALPHA
+	};
+
+	/// <summary>
+	/// Program, texture and blending of a sprite. Sprites of different materials can share
+	/// one begin()/end(), renderBatch() switches program and blending only where the material changes.
+	/// The programs must read the batch's VertexFormat attributes and have their uniforms set beforehand.
+	/// </summary>
+	struct Material {
+		Material() {}
+		Material(GLSLProgram* programPtr, GLuint textureId, BlendMode blendMode) :
+			program(programPtr), texture(textureId), blend(blendMode) {}
+		GLSLProgram* program = nullptr; ///< nullptr for the program bound when renderBatch() is called
+		GLuint texture = 0;
+		BlendMode blend = BlendMode::CURRENT;
+	};
+
+	/// Per frame counters of a SpriteBatch, reset by begin()
+	struct SpriteBatchStats {
+		size_t keptSprites = 0;
+		size_t culledSprites = 0; ///< rejected by the cull rect before any vertex work
+		bool fastSort = false; ///< end() didn't need a full sort
 	};
 
+	/// A range of the shared quad index buffer (or of instances) drawn with one texture and render state
 	class RenderBatch {
 	public:
-		RenderBatch(GLuint offsetVal, GLuint verticesCount, GLuint textureId) : 
-			offset(offsetVal), numVertices(verticesCount), m_texture(textureId) {}
-		GLuint offset;
-		GLuint numVertices;
+		RenderBatch(GLuint offsetVal, GLuint indicesCount, GLuint textureId, GLuint stateId = 0) : 
+			offset(offsetVal), numIndices(indicesCount), m_texture(textureId), m_state(stateId) {}
+		GLuint offset; ///< first index, or first instance
+		GLuint numIndices; ///< or number of instances
 		GLuint m_texture;
+		GLuint m_state; ///< program and blending, see SpriteBatch::RenderState
+		bool m_translucent = false; ///< drawn in the blended pass of VertexFormat::DEPTH
+	};
+
+	/// <summary>
+	/// Sprites recorded by one producer thread for a SpriteBatch, see SpriteBatch::addSubmitBuffers.
+	/// Different buffers can be filled at the same time without a lock, SpriteBatch::end() merges them
+	/// in index order, so the frame comes out the same however the threads were scheduled.
+	/// Culling happens here, the vertices are written when merging.
+	/// </summary>
+	class SpriteSubmitBuffer
+	{
+	public:
+		void draw(const glm::vec4& destRect, const glm::vec4& uvRect, GLuint texture, float depth, const ColorRGBA8& color, float angle = 0.f);
+		void draw(const glm::vec4& destRect, const glm::vec4& uvRect, const GLTexture& texture, float depth, const ColorRGBA8& color, float angle = 0.f);
+		void draw(const glm::vec4& destRect, const glm::vec4& uvRect, const Material& material, float depth, const ColorRGBA8& color, float angle = 0.f);
+		void drawMany(const SpriteInstance* sprites, size_t count, GLuint texture, float depth = 0.f);
+		void drawMany(const SpriteInstance* sprites, size_t count, const Material& material, float depth = 0.f);
+
+		size_t getNumSprites() const { return m_sprites.size(); }
+
+	private:
+		friend class SpriteBatch;
+
+		/// consecutive sprites sharing material, texture layer and depth
+		struct Run {
+			Material material;
+			GLuint layer;
+			float depth;
+			size_t end; ///< one past its last sprite in m_sprites
+		};
+
+		/// empties the buffer, its sprites go to renderLayer and are culled by cullRect when cull is set
+		void reset(uint8_t renderLayer, bool cull, const glm::vec4& cullRect);
+		/// the run the next sprites are added to
+		void useRun(const Material& material, GLuint layer, float depth);
+		void addSprite(const glm::vec4& destRect, const glm::vec4& uvRect, const ColorRGBA8& color, const glm::vec2& rotation);
+
+		std::vector<SpriteInstance> m_sprites;
+		std::vector<Run> m_runs;
+		uint8_t m_renderLayer = 0;
+		bool m_cull = false;
+		glm::vec4 m_cullRect;
+		size_t m_culledSprites = 0;
 	};
 
 
@@ -46,35 +143,313 @@ namespace ge {
 		SpriteBatch();
 		~SpriteBatch();
 
-		void init();
+		void init(VertexUpload upload = VertexUpload::ORPHAN, VertexFormat format = VertexFormat::STANDARD,
+			BatchProcessing processing = BatchProcessing::MAIN_THREAD);
+		/// <summary>
+		/// frees the vertex array and buffers, the shared index buffer with the last batch.
+		/// Call it while the GL context is alive, init() makes the batch usable again
+		/// </summary>
+		void dispose();
 
-		void begin(GlyphSortType sortBy = GlyphSortType::TEXTURE);
+		/// <summary>
+		/// starts a new frame of sprites
+		/// </summary>
+		/// <param name="cullCamera">if set, sprites outside its view are dropped in draw()</param>
+		void begin(GlyphSortType sortBy = GlyphSortType::TEXTURE, const Camera2D* cullCamera = nullptr);
 		void end();
 
 		/// <summary>
-		/// adds a Glyph to the sprite batch
+		/// sprites drawn from now on go to layer (0 after begin()). With any sort type but NONE
+		/// lower layers come first, and renderLayer() draws a single one, see RenderQueue
+		/// </summary>
+		/// <param name="cullCamera">replaces the one given to begin()</param>
+		void setRenderLayer(uint8_t layer, const Camera2D* cullCamera = nullptr);
+
+		/// <summary>
+		/// adds a sprite to the sprite batch, its vertices are written right away
 		/// </summary>
 		void draw(const glm::vec4& destRect, const glm::vec4& uvRect, GLuint m_texture, float depth, const ColorRGBA8& color);
 		void draw(const glm::vec4& destRect, const glm::vec4& uvRect, GLuint m_texture, float depth, const ColorRGBA8& color, float angle);
 		void draw(const glm::vec4& destRect, const glm::vec4& uvRect, GLuint m_texture, float depth, const ColorRGBA8& color, const glm::vec2& dir);
+		/// maps uvRect into the texture's atlas rect and takes its layer (see ResourceManager::getLayeredTexture)
+		void draw(const glm::vec4& destRect, const glm::vec4& uvRect, const GLTexture& texture, float depth, const ColorRGBA8& color, float angle = 0.f);
+		/// <summary>
+		/// adds a sprite with its own program and blending. With GlyphSortType::TEXTURE the sprites are
+		/// grouped by program and blending in the order those were first drawn this frame, so a material
+		/// first drawn later ends up on top of the earlier ones
+		/// </summary>
+		void draw(const glm::vec4& destRect, const glm::vec4& uvRect, const Material& material, float depth, const ColorRGBA8& color, float angle = 0.f);
+
+		/// <summary>
+		/// adds count sprites sharing a texture and depth in one go, the store grows once
+		/// </summary>
+		void drawMany(const SpriteInstance* sprites, size_t count, GLuint texture, float depth = 0.f);
+		/// <summary>
+		/// same as above from separate arrays, unrotated
+		/// </summary>
+		/// <param name="uvRects">nullptr draws the whole texture on every sprite</param>
+		void drawMany(const glm::vec4* destRects, const glm::vec4* uvRects, const ColorRGBA8* colors, size_t count, GLuint texture, float depth = 0.f);
+		void drawMany(const SpriteInstance* sprites, size_t count, const Material& material, float depth = 0.f);
+
+		/// <summary>
+		/// makes count more submission buffers for this frame, for producer threads to draw into concurrently.
+		/// They draw into the current render layer and are culled by the current cull camera.
+		/// Call it on the thread that owns the batch, before the producers start. end() merges the buffers
+		/// in index order after the sprites drawn straight into the batch
+		/// </summary>
+		/// <returns>index of the first new buffer</returns>
+		size_t addSubmitBuffers(size_t count);
+		/// each buffer must be filled by one thread at a time
+		SpriteSubmitBuffer& getSubmitBuffer(size_t index) { return *m_submitBuffers[index]; }
+		size_t getNumSubmitBuffers() const { return m_numSubmitBuffers; }
 
 		/// <summary>
 		/// renders entire SpriteBatch
 		/// </summary>
 		void renderBatch();
+		/// <summary>
+		/// renders only the sprites drawn into layer, so each layer can get its own program and camera
+		/// </summary>
+		void renderLayer(uint8_t layer);
+
+		/// <summary>
+		/// writes the 4 vertices of a sprite: topLeft, bottomLeft, bottomRight, topRight.
+		/// draw() defers the rotation instead, and transforms all rotated sprites at once in end()
+		/// </summary>
+		static void setQuad(Vertex* quad, const glm::vec4& destRect, const glm::vec4& uvRect, const ColorRGBA8& color, float angle);
+		/// <summary>
+		/// the VertexFormat::COMPACT upload of a vertex, its position relative to origin. See CompactVertex for the precision
+		/// </summary>
+		static void encodeCompactVertex(const Vertex& vertex, const glm::vec2& origin, CompactVertex& out);
+
+		/// <summary>
+		/// Vertex shader for VertexFormat::INSTANCED, pair it with any of the texture fragment shaders.
+		/// Attributes must be added in this order: instanceDestRect, instanceUV, instanceColor, instanceRotation
+		/// </summary>
+		static const char* INSTANCED_VERT_SRC;
+
+		/// <summary>
+		/// Shaders for VertexFormat::LAYERED, sprites sharing a texture array are drawn together.
+		/// Attributes must be added in this order: vertexPosition, vertexColor, vertexUV, vertexLayer
+		/// </summary>
+		static const char* LAYERED_VERT_SRC;
+		static const char* LAYERED_FRAG_SRC;
+
+		/// <summary>
+		/// Vertex shader for VertexFormat::COMPACT, pair it with any of the texture fragment shaders.
+		/// Attributes must be added in this order: vertexPosition, vertexColor, vertexUV, vertexOrigin
+		/// </summary>
+		static const char* COMPACT_VERT_SRC;
+
+		/// <summary>
+		/// Shaders for VertexFormat::DEPTH, depths go from -1 (front) to 1 (back). A sprite is opaque when its color
+		/// alpha is 255 and its material blending isn't additive or premultiplied, the fragment shader cuts out
+		/// its texels under half alpha so they don't write depth.
+		/// Attributes must be added in this order: vertexPosition, vertexColor, vertexUV
+		/// </summary>
+		static const char* DEPTH_VERT_SRC;
+		static const char* DEPTH_FRAG_SRC;
+
+		// getters
+		const SpriteBatchStats& getStats() const { return m_stats; }
+		/// frames whose sort was skipped or done by merging a few runs
+		size_t getNumFastSortFrames() const { return m_numFastSortFrames; }
+
+		/// program and blend combinations one frame can use
+		static const size_t MAX_RENDER_STATES = 256;
+
+		/// sorted sprites are uploaded in submission order, and drawn as ranges of it,
+		/// when the ranges are this long on average. Shorter ones get copied into draw order
+		static const size_t MIN_SPRITES_PER_RANGE = 16;
 
 	private:
+		friend class SpriteSubmitBuffer;
+
+		/// the part of a Material that isn't the texture, plus the render layer
+		struct RenderState {
+			GLSLProgram* program;
+			BlendMode blend;
+			uint8_t renderLayer;
+		};
+
+		/// layout glMultiDrawArraysIndirect reads
+		struct DrawArraysIndirectCommand {
+			GLuint count;
+			GLuint instanceCount;
+			GLuint first;
+			GLuint baseInstance;
+		};
+
+		/// GL state renderBatch() found bound, restored once it is done
+		struct BoundState {
+			GLint program;
+			GLboolean blend;
+			GLint srcRGB, dstRGB, srcAlpha, dstAlpha;
+			GLboolean depthTest, depthWrite;
+			GLint depthFunc;
+		};
+
+		/// index of the render state in m_states, added on first use
+		uint8_t getStateIndex(GLSLProgram* program, BlendMode blend);
+		/// binds program and blending of a render state, nullptr and BlendMode::CURRENT fall back to bound
+		static void applyState(const RenderState& state, const BoundState& bound);
+		static void restoreState(const BoundState& bound);
+
+		void setCullCamera(const Camera2D* cullCamera);
+		/// the CPU part of end(): rotations, sorting, render batches and vertices, no GL calls
+		void prepareFrame();
+		/// waits for the worker started by end(), then uploads what it prepared
+		void finishWorker();
+		/// adds the frame's sort and cull counters to RenderStats, on the main thread
+		void reportStats();
+		/// draws every batch, or only those of layer when oneLayer is set
+		void drawBatches(bool oneLayer, uint8_t layer);
+		/// draws renderBatches[first, end), which share texture and state, returns the number of draw calls
+		size_t drawRun(size_t first, size_t end, bool baseInstance, bool multiDrawIndirect);
+		/// one command per batch into m_indirectBuffer and leaves it bound, false if there is nothing to multi draw
+		bool uploadIndirectCommands();
+		/// ranges of consecutive sprites with the same texture and state in the sorted keys
+		size_t countSortedRanges() const;
+		/// replaces the keys of VertexFormat::DEPTH: opaque sprites by state and texture, then translucent ones back to front
+		void makeDepthPassKeys();
+		/// fills m_sortGroups with the render layers, left empty when the frame has only one
+		void makeLayerGroups();
+		/// stable counting sort of the sorted keys by m_sortGroups, so lower groups come first
+		void groupKeys();
+		uint16_t getSortGroup(size_t s) const { return m_sortGroups.empty() ? 0 : m_sortGroups[s]; }
+		bool isTranslucent(size_t s) const;
+
 		void createRenderBatches();
+		/// render batches of WORKER_THREAD, the sprites are written to the store or the staging buffer for uploadPreparedSprites
+		void prepareRenderBatches();
+		void uploadPreparedSprites();
+		/// true if the sorted sprites should be drawn from where they are in the store
+		bool useInPlace() const;
+		/// fills renderBatches and writes the sprites to dest, which must hold m_numSprites
+		void buildRenderBatches(unsigned char* dest, bool inPlace);
+		/// the store is uploaded as it is, no per-vertex conversion
+		bool storeIsUploadLayout() const { return m_format == VertexFormat::STANDARD || m_format == VertexFormat::INSTANCED; }
 		void createVertexArray();
+		void setVertexAttribPointers();
+		/// points the instance attributes at firstInstance, when there is no base instance support
+		void setInstanceAttribPointers(GLuint firstInstance);
+		/// <summary>
+		/// Orders m_sortKeys, trying the cheap cases first: keys already in order,
+		/// keys in the same order as last frame, keys made of a few sorted runs.
+		/// Only the rest gets a full radix sort.
+		/// </summary>
 		void sortGlyphs();
+		/// true if the keys are ordered when read in last frame's order, they are then put in that order
+		bool reuseLastOrder();
+
+		/// reserves the next quad in the store and returns its 4 vertices
+		Vertex* addQuad(GLuint texture, uint8_t state, float depth);
+		/// reserves the next instance in the store
+		SpriteInstance* addInstance(GLuint texture, uint8_t state, float depth);
+		void addSprite(GLuint texture, uint8_t state, float depth);
+		/// grows the store to hold count more sprites
+		void reserveSprites(size_t count);
+		/// adds count sprites of one texture layer, state and depth, the store grows once
+		void appendSprites(const SpriteInstance* sprites, size_t count, GLuint texture, GLuint layer, uint8_t state, float depth);
+		/// writes sprite s of a drawMany into the store, false if it got culled
+		bool appendSprite(size_t s, const glm::vec4& destRect, const glm::vec4& uvRect, const ColorRGBA8& color, const glm::vec2& rotation, GLuint layer);
+		/// adds textures and keys of the sprites appended from m_numSprites up to end
+		void commitSprites(size_t end, GLuint texture, uint8_t state, float depth);
+		/// rotation is (cos, sin), (1, 0) for an axis aligned sprite
+		void drawSprite(const glm::vec4& destRect, const glm::vec4& uvRect, GLuint texture, GLuint layer, uint8_t state, float depth, const ColorRGBA8& color, const glm::vec2& rotation);
+		/// false if the sprite is surely outside cullRect, rotated ones are tested by their bounding circle
+		static bool isVisible(const glm::vec4& cullRect, const glm::vec4& destRect, const glm::vec2& rotation);
+		/// appends the sprites of the submission buffers, in index order
+		void mergeSubmitBuffers();
+		/// positions of the sprites queued by drawSprite, many sprites per transformQuads call
+		void transformRotatedSprites();
+
+		/// bytes of a vertex (or instance) in the upload
+		size_t getVertexSize() const;
+		/// bytes a sprite takes in the upload
+		size_t getSpriteSize() const;
+		/// writes the upload layout of sprite s to dest
+		void writeSprite(unsigned char* dest, size_t s) const;
+
+		static void setQuadColorUV(Vertex* quad, const glm::vec4& uvRect, const ColorRGBA8& color);
+		static void setQuadPositions(Vertex* quad, const glm::vec4& destRect);
+		/// center of this frame's sprites, the VertexFormat::COMPACT positions are relative to it
+		void computeOrigin();
+
+		/// Grows the shared index buffer to hold at least numQuads quads
+		static void reserveQuadIndices(size_t numQuads);
 
 		GLuint vbo;
 		GLuint vao;
 		GlyphSortType sortType;
 
-		std::vector <Glyph*> glyphPtrs;
-		std::vector <Glyph> glyphs;
+		VertexUpload m_upload = VertexUpload::ORPHAN;
+		VertexFormat m_format = VertexFormat::STANDARD;
+		BatchProcessing m_processing = BatchProcessing::MAIN_THREAD;
+		StreamBuffer m_streamBuffer;
+		GLuint m_boundVbo = 0; ///< buffer the vao attributes point to
+		GLint m_firstVertex = 0; ///< start of this frame's vertices (or instances) in the bound buffer
+		std::vector <unsigned char> m_staging; ///< sorted upload for VertexUpload::ORPHAN, kept to reuse its capacity
+		glm::vec2 m_origin = glm::vec2(0.f); ///< VertexFormat::COMPACT batch origin
+
+		bool m_cull = false;
+		glm::vec4 m_cullRect; ///< x, y, width, height in world units
+		SpriteBatchStats m_stats;
+
+		// 0,1,2, 2,3,0 index pattern shared by every SpriteBatch
+		static GLuint s_quadIbo;
+		static size_t s_numQuadIndices; ///< capacity in quads
+		static size_t s_numBatches; ///< initialized batches sharing s_quadIbo
+
+		// persistent sprite store, draw() writes each sprite once and end() only
+		// sorts the keys, the capacity is kept between frames
+		std::vector <Vertex> m_quadVertices; ///< 4 per sprite: topLeft, bottomLeft, bottomRight, topRight
+		std::vector <SpriteInstance> m_instances; ///< 1 per sprite with VertexFormat::INSTANCED
+		std::vector <GLuint> m_spriteTextures; ///< 1 per sprite
+		std::vector <GLuint> m_spriteLayers; ///< 1 per sprite with VertexFormat::LAYERED
+		std::vector <uint8_t> m_spriteStates; ///< 1 per sprite, index into m_states
+		std::vector <float> m_spriteDepths; ///< 1 per sprite with VertexFormat::DEPTH
+		size_t m_numSprites = 0;
+
+		// rotated sprites waiting for their positions
+		std::vector <uint32_t> m_rotatedSprites; ///< sprite indices
+		std::vector <glm::vec4> m_rotatedRects;
+		std::vector <glm::vec2> m_rotations;
+		std::vector <glm::vec2> m_rotatedCorners;
+
+		SpriteSortKeys m_keyBuilder;
+		std::vector <uint64_t> m_sortKeys; ///< one per sprite, in draw order until sorted, unused with GlyphSortType::NONE
+		std::vector <uint64_t> m_sortScratch;
+		std::vector <uint32_t> m_lastOrder; ///< sprite indices in last frame's sorted order, empty if it was the submission order
+		/// <summary>
+		/// 1 per sprite, sorted before the keys: the render layer, and the pass with VertexFormat::DEPTH.
+		/// Kept out of the keys so depths keep all their bits. Empty when every sprite is in the same group
+		/// </summary>
+		std::vector <uint16_t> m_sortGroups;
+		std::vector <size_t> m_groupOffsets;
+		/// 256 render layers times the 2 passes of VertexFormat::DEPTH
+		static const size_t MAX_SORT_GROUPS = 512;
+		size_t m_numFastSortFrames = 0;
+
+		std::vector <RenderState> m_states; ///< this frame's program and blend combinations, in first use order
+		uint8_t m_lastState = 0; ///< most sprites reuse the state of the previous one
+		uint8_t m_renderLayer = 0; ///< of the sprites being drawn
 		std::vector <RenderBatch> renderBatches;
 
+		// kept between frames to reuse their capacity, unique_ptr so handed out references stay valid
+		std::vector <std::unique_ptr<SpriteSubmitBuffer>> m_submitBuffers;
+		size_t m_numSubmitBuffers = 0; ///< in use this frame
+
+		// multi draw parameters, kept to reuse their capacity
+		std::vector <GLsizei> m_multiCounts;
+		std::vector <const void*> m_multiOffsets;
+		std::vector <GLint> m_multiBaseVertices;
+		std::vector <DrawArraysIndirectCommand> m_indirectCommands;
+		GLuint m_indirectBuffer = 0;
+
+		// BatchProcessing::WORKER_THREAD
+		const unsigned char* m_preparedSprites = nullptr; ///< what uploadPreparedSprites sends, nullptr once sent
+		std::future<void> m_worker; ///< last, so it is waited for before anything it uses is destroyed
+
 	};
 } //namespace ge
\ No newline at end of file
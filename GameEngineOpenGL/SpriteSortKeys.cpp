@@ -0,0 +1,70 @@
+#include "SpriteSortKeys.h"
+#include "RadixSort.h"
+#include <algorithm>
+
+namespace ge {
+
+	void SpriteSortKeys::begin(GlyphSortType sortType)
+	{
+		m_sortType = sortType;
+		m_textureIndices.clear();
+	}
+
+	uint64_t SpriteSortKeys::makeKey(GLuint texture, uint8_t state, float depth, uint32_t index)
+	{
+		uint32_t primary = 0;
+		switch (m_sortType) {
+		case GlyphSortType::FRONT_TO_BACK:
+			primary = floatToSortable(depth);
+			break;
+		case GlyphSortType::BACK_TO_FRONT:
+			primary = ~floatToSortable(depth);
+			break;
+		case GlyphSortType::TEXTURE:
+			// state before texture so each program and blend mode is set once.
+			// A frame has far fewer than 2^24 textures, their indices always fit
+			primary = ((uint32_t)state << 24) | getTextureIndex(texture);
+			break;
+		default:
+			break;
+		}
+		return ((uint64_t)primary << 32) | index;
+	}
+
+	void SpriteSortKeys::rankTextures(std::vector<uint64_t>& keys)
+	{
+		if (m_sortType != GlyphSortType::TEXTURE || m_textureIndices.size() < 2) { return; }
+
+		// a handful of textures per frame, sorting their names is cheap
+		m_sortedTextures.assign(m_textureIndices.begin(), m_textureIndices.end());
+		std::sort(m_sortedTextures.begin(), m_sortedTextures.end());
+
+		m_textureRanks.resize(m_sortedTextures.size());
+		bool inNameOrder = true;
+		for (uint32_t rank = 0; rank < m_sortedTextures.size(); rank++) {
+			m_textureRanks[m_sortedTextures[rank].second] = rank;
+			inNameOrder &= m_sortedTextures[rank].second == rank;
+		}
+		// the first use order already is the name order
+		if (inNameOrder) { return; }
+
+		for (uint64_t& key : keys) {
+			const uint32_t primary = (uint32_t)(key >> 32);
+			const uint32_t ranked = (primary & 0xFF000000u) | m_textureRanks[primary & 0x00FFFFFFu];
+			key = ((uint64_t)ranked << 32) | (uint32_t)key;
+		}
+	}
+
+	uint32_t SpriteSortKeys::getTextureIndex(GLuint texture)
+	{
+		if (!m_textureIndices.empty() && texture == m_lastTexture) { return m_lastTextureIndex; }
+
+		auto it = m_textureIndices.find(texture);
+		if (it == m_textureIndices.end()) {
+			it = m_textureIndices.emplace(texture, (uint32_t)m_textureIndices.size()).first;
+		}
+		m_lastTexture = texture;
+		m_lastTextureIndex = it->second;
+		return m_lastTextureIndex;
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <GL\glew.h>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ge {
+
+	/// How SpriteBatch and StaticSpriteBatch order their sprites, ties keep the submission order
+	enum class GlyphSortType {
+		NONE,			///< submission order
+		FRONT_TO_BACK,	///< ascending depth
+		BACK_TO_FRONT,	///< descending depth
+		TEXTURE			///< by render state (SpriteBatch materials, in first use order), then by texture name
+	};
+
+	/// <summary>
+	/// Builds the 64-bit sort keys of SpriteBatch and StaticSpriteBatch: the sort criteria in the
+	/// high word, the submission index in the low word, so a radix sort of the keys is stable.
+	/// Makes no GL calls, so the keys can be checked without a context.
+	/// </summary>
+	class SpriteSortKeys
+	{
+	public:
+		/// starts a new frame, forgetting the textures of the last one
+		void begin(GlyphSortType sortType);
+
+		/// <summary>
+		/// key of the sprite at index. TEXTURE keys hold the texture's first use index
+		/// until rankTextures(), so any texture name fits next to the state
+		/// </summary>
+		uint64_t makeKey(GLuint texture, uint8_t state, float depth, uint32_t index);
+
+		/// <summary>
+		/// replaces the first use indices of TEXTURE keys with the rank of the texture name among
+		/// this frame's textures, so the keys sort by texture name. Call it once all the keys are made
+		/// </summary>
+		void rankTextures(std::vector<uint64_t>& keys);
+
+	private:
+		uint32_t getTextureIndex(GLuint texture);
+
+		GlyphSortType m_sortType = GlyphSortType::TEXTURE;
+		std::unordered_map<GLuint, uint32_t> m_textureIndices; ///< this frame's textures, in first use order
+		GLuint m_lastTexture = 0; ///< most sprites reuse the texture of the previous one
+		uint32_t m_lastTextureIndex = 0;
+
+		std::vector<std::pair<GLuint, uint32_t>> m_sortedTextures; ///< (name, first use index) by name
+		std::vector<uint32_t> m_textureRanks; ///< by first use index
+	};
+}
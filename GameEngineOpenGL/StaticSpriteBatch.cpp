@@ -0,0 +1,263 @@
+#include "StaticSpriteBatch.h"
+#include "RadixSort.h"
+#include "ErrManager.h"
+#include "RenderStats.h"
+#include <cstddef>
+#include <cstring>
+
+namespace ge {
+
+	StaticSpriteBatch::StaticSpriteBatch() { /* empty */ }
+
+	StaticSpriteBatch::~StaticSpriteBatch() { /* empty */ }
+
+	void StaticSpriteBatch::init(GlyphSortType sortBy /* = GlyphSortType::TEXTURE */)
+	{
+		m_sortType = sortBy;
+
+		GLCall(glGenVertexArrays(1, &m_vao));
+		GLCall(glGenBuffers(1, &m_vbo));
+		GLCall(glGenBuffers(1, &m_ibo));
+
+		GLCall(glBindVertexArray(m_vao));
+		GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
+
+		// same layout as SpriteBatch with VertexFormat::STANDARD
+		GLCall(glEnableVertexAttribArray(0));
+		GLCall(glEnableVertexAttribArray(1));
+		GLCall(glEnableVertexAttribArray(2));
+
+		GLCall(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE,
+			sizeof(Vertex), (void *)offsetof(Vertex, pos)));
+		GLCall(glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE,
+			sizeof(Vertex), (void *)offsetof(Vertex, color)));
+		GLCall(glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE,
+			sizeof(Vertex), (void *)offsetof(Vertex, uv)));
+
+		// the element buffer binding is part of the vao state
+		GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo));
+
+		GLCall(glBindVertexArray(0));
+		GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+	}
+
+	void StaticSpriteBatch::dispose()
+	{
+		if (m_vao) {
+			GLCall(glDeleteVertexArrays(1, &m_vao));
+			m_vao = 0;
+		}
+		if (m_vbo) {
+			GLCall(glDeleteBuffers(1, &m_vbo));
+			m_vbo = 0;
+		}
+		if (m_ibo) {
+			GLCall(glDeleteBuffers(1, &m_ibo));
+			m_ibo = 0;
+		}
+		m_vboCapacity = 0;
+	}
+
+	SpriteHandle StaticSpriteBatch::add(const glm::vec4 & destRect, const glm::vec4 & uvRect, GLuint texture, float depth, const ColorRGBA8 & color, float angle /* = 0.f */)
+	{
+		SpriteHandle handle = allocSlot(texture, depth);
+		SpriteBatch::setQuad(&m_vertices[handle * 4], destRect, uvRect, color, angle);
+		markDirty(handle);
+		return handle;
+	}
+
+	SpriteHandle StaticSpriteBatch::add(const glm::vec4 & destRect, const glm::vec4 & uvRect, const GLTexture & texture, float depth, const ColorRGBA8 & color, float angle /* = 0.f */)
+	{
+		return add(destRect, texture.subUV(uvRect), texture.id, depth, color, angle);
+	}
+
+	void StaticSpriteBatch::update(SpriteHandle handle, const glm::vec4 & destRect, const glm::vec4 & uvRect, const ColorRGBA8 & color, float angle /* = 0.f */)
+	{
+		// a removed sprite isn't drawn, its free slot shouldn't cost an upload
+		if (!m_used[handle]) { return; }
+
+		Vertex quad[4];
+		SpriteBatch::setQuad(quad, destRect, uvRect, color, angle);
+
+		// callers can update every frame, only real changes cost an upload
+		Vertex* stored = &m_vertices[handle * 4];
+		if (std::memcmp(stored, quad, sizeof(quad)) == 0) { return; }
+
+		std::memcpy(stored, quad, sizeof(quad));
+		markDirty(handle);
+	}
+
+	void StaticSpriteBatch::setTexture(SpriteHandle handle, GLuint texture, float depth)
+	{
+		if (!m_used[handle]) { return; }
+
+		m_textures[handle] = texture;
+		m_depths[handle] = depth;
+		m_indicesDirty = true;
+	}
+
+	void StaticSpriteBatch::remove(SpriteHandle handle)
+	{
+		if (!m_used[handle]) { return; }
+
+		// the vertices stay in the vbo, they just aren't indexed anymore
+		m_used[handle] = false;
+		m_freeSlots.push_back(handle);
+		m_numSprites--;
+		m_indicesDirty = true;
+	}
+
+	void StaticSpriteBatch::clear()
+	{
+		m_vertices.clear();
+		m_textures.clear();
+		m_used.clear();
+		m_depths.clear();
+		m_freeSlots.clear();
+		m_numSprites = 0;
+		m_dirtyBegin = m_dirtyEnd = 0;
+		m_indicesDirty = true;
+	}
+
+	void StaticSpriteBatch::renderBatch()
+	{
+		if (m_indicesDirty) {
+			rebuildIndices();
+		}
+		uploadVertices();
+
+		GLCall(glBindVertexArray(m_vao));
+
+		for (size_t i = 0; i < m_renderBatches.size(); i++) {
+			const RenderBatch& batch = m_renderBatches[i];
+			GLCall(glBindTexture(GL_TEXTURE_2D, batch.m_texture));
+			GLCall(glDrawElements(GL_TRIANGLES, batch.numIndices, GL_UNSIGNED_INT,
+				(void *)(batch.offset * sizeof(GLuint))));
+		}
+
+		GLCall(glBindVertexArray(0));
+
+		FrameRenderStats& stats = RenderStats::current();
+		stats.sprites += m_numSprites;
+		stats.renderBatches += m_renderBatches.size();
+		stats.drawCalls += m_renderBatches.size();
+		stats.textureBinds += m_renderBatches.size();
+	}
+
+	SpriteHandle StaticSpriteBatch::allocSlot(GLuint texture, float depth)
+	{
+		SpriteHandle handle;
+		if (!m_freeSlots.empty()) {
+			handle = m_freeSlots.back();
+			m_freeSlots.pop_back();
+		}
+		else {
+			handle = (SpriteHandle)m_textures.size();
+			m_textures.push_back(0);
+			m_used.push_back(false);
+			m_depths.push_back(0.f);
+			m_vertices.resize(m_vertices.size() + 4);
+		}
+
+		m_textures[handle] = texture;
+		m_used[handle] = true;
+		m_depths[handle] = depth;
+		m_numSprites++;
+		m_indicesDirty = true;
+		return handle;
+	}
+
+	void StaticSpriteBatch::markDirty(SpriteHandle handle)
+	{
+		if (m_dirtyBegin == m_dirtyEnd) {
+			m_dirtyBegin = handle;
+			m_dirtyEnd = handle + 1;
+			return;
+		}
+		if (handle < m_dirtyBegin) m_dirtyBegin = handle;
+		if (handle + 1 > m_dirtyEnd) m_dirtyEnd = handle + 1;
+	}
+
+	void StaticSpriteBatch::uploadVertices()
+	{
+		const size_t numSlots = m_textures.size();
+		const size_t slotSize = 4 * sizeof(Vertex);
+
+		if (numSlots > m_vboCapacity) {
+			// growing twice, so adding sprites one by one doesn't reallocate every frame
+			m_vboCapacity = m_vboCapacity * 2;
+			if (m_vboCapacity < numSlots) m_vboCapacity = numSlots;
+
+			GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
+			GLCall(glBufferData(GL_ARRAY_BUFFER, m_vboCapacity * slotSize, nullptr, GL_STATIC_DRAW));
+			GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, numSlots * slotSize, m_vertices.data()));
+			GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+
+			RenderStats::current().bytesUploaded += numSlots * slotSize;
+
+			m_dirtyBegin = m_dirtyEnd = 0;
+			return;
+		}
+
+		if (m_dirtyBegin == m_dirtyEnd) { return; }
+
+		GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
+		GLCall(glBufferSubData(GL_ARRAY_BUFFER, m_dirtyBegin * slotSize,
+			(m_dirtyEnd - m_dirtyBegin) * slotSize, &m_vertices[m_dirtyBegin * 4]));
+		GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+
+		RenderStats::current().bytesUploaded += (m_dirtyEnd - m_dirtyBegin) * slotSize;
+
+		m_dirtyBegin = m_dirtyEnd = 0;
+	}
+
+	void StaticSpriteBatch::rebuildIndices()
+	{
+		m_indicesDirty = false;
+		m_renderBatches.clear();
+		m_indices.clear();
+		m_sortKeys.clear();
+
+		// same keys as SpriteBatch with a single render state, the low word is the slot
+		m_keyBuilder.begin(m_sortType);
+		for (size_t s = 0; s < m_textures.size(); s++) {
+			if (!m_used[s]) continue;
+			m_sortKeys.push_back(m_keyBuilder.makeKey(m_textures[s], 0, m_depths[s], (uint32_t)s));
+		}
+		m_keyBuilder.rankTextures(m_sortKeys);
+
+		if (m_sortType != GlyphSortType::NONE) {
+			radixSort(m_sortKeys, m_sortScratch, 4);
+		}
+
+		m_indices.reserve(m_sortKeys.size() * 6);
+		for (size_t i = 0; i < m_sortKeys.size(); i++) {
+			const GLuint s = (uint32_t)m_sortKeys[i];
+			const GLuint texture = m_textures[s];
+
+			if (i == 0 || texture != m_renderBatches.back().m_texture) {
+				m_renderBatches.emplace_back((GLuint)m_indices.size(), 6, texture);
+			}
+			else {
+				m_renderBatches.back().numIndices += 6;
+			}
+
+			// topLeft, bottomLeft, bottomRight, topRight
+			const GLuint v = s * 4;
+			m_indices.push_back(v + 0);
+			m_indices.push_back(v + 1);
+			m_indices.push_back(v + 2);
+			m_indices.push_back(v + 2);
+			m_indices.push_back(v + 3);
+			m_indices.push_back(v + 0);
+		}
+
+		// binding with no vao, the vao already references m_ibo
+		GLCall(glBindVertexArray(0));
+		GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo));
+		GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(GLuint), m_indices.data(), GL_STATIC_DRAW));
+		GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+
+		RenderStats::current().bytesUploaded += m_indices.size() * sizeof(GLuint);
+	}
+}
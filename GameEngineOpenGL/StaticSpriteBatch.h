@@ -0,0 +1,87 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <GL\glew.h>
+#include "Vertex.h"
+#include "GLTexture.h"
+#include "SpriteBatch.h"
+
+namespace ge {
+
+	/// Stable id of a sprite in a StaticSpriteBatch, valid until it is removed
+	typedef uint32_t SpriteHandle;
+
+	/// <summary>
+	/// Retained counterpart of SpriteBatch for content that rarely changes (tile maps, editor scenes).
+	/// Sprites stay in GL_STATIC_DRAW buffers between frames, renderBatch() only uploads
+	/// the vertex range touched since the last frame, and rebuilds the index buffer only
+	/// when sprites are added, removed or change texture.
+	/// Works with the same shaders as VertexFormat::STANDARD.
+	/// </summary>
+	class StaticSpriteBatch
+	{
+	public:
+		StaticSpriteBatch();
+		~StaticSpriteBatch();
+
+		void init(GlyphSortType sortBy = GlyphSortType::TEXTURE);
+		/// frees the buffers, needs the GL context, so the destructor doesn't call it
+		void dispose();
+
+		SpriteHandle add(const glm::vec4& destRect, const glm::vec4& uvRect, GLuint texture, float depth, const ColorRGBA8& color, float angle = 0.f);
+		/// maps uvRect into the texture's atlas rect
+		SpriteHandle add(const glm::vec4& destRect, const glm::vec4& uvRect, const GLTexture& texture, float depth, const ColorRGBA8& color, float angle = 0.f);
+
+		/// <summary>
+		/// Rewrites the sprite's vertices, only its range gets re-uploaded. Does nothing if they didn't change or the sprite was removed.
+		/// </summary>
+		void update(SpriteHandle handle, const glm::vec4& destRect, const glm::vec4& uvRect, const ColorRGBA8& color, float angle = 0.f);
+		/// changes the draw order, so the index buffer gets rebuilt. Does nothing if the sprite was removed
+		void setTexture(SpriteHandle handle, GLuint texture, float depth);
+		/// does nothing for a handle that was already removed
+		void remove(SpriteHandle handle);
+		void clear();
+
+		/// <summary>
+		/// uploads pending changes and renders all the sprites
+		/// </summary>
+		void renderBatch();
+
+		// getters
+		size_t getNumSprites() const { return m_numSprites; }
+
+	private:
+		SpriteHandle allocSlot(GLuint texture, float depth);
+		void markDirty(SpriteHandle handle);
+
+		/// reallocates the vbo when it is too small, otherwise uploads the dirty range
+		void uploadVertices();
+		/// sorts the live sprites and writes the index buffer and the batches
+		void rebuildIndices();
+
+		GLuint m_vbo = 0;
+		GLuint m_ibo = 0;
+		GLuint m_vao = 0;
+		GlyphSortType m_sortType = GlyphSortType::TEXTURE;
+
+		std::vector<Vertex> m_vertices; ///< 4 per slot, in slot order like the vbo
+		std::vector<GLuint> m_textures; ///< 1 per slot
+		std::vector<bool> m_used; ///< 1 per slot, false for free slots
+		std::vector<float> m_depths; ///< 1 per slot
+		std::vector<SpriteHandle> m_freeSlots;
+		size_t m_numSprites = 0;
+
+		size_t m_vboCapacity = 0; ///< in slots
+		size_t m_dirtyBegin = 0; ///< slot range waiting for glBufferSubData
+		size_t m_dirtyEnd = 0;
+		bool m_indicesDirty = false;
+
+		SpriteSortKeys m_keyBuilder;
+		std::vector<uint64_t> m_sortKeys;
+		std::vector<uint64_t> m_sortScratch;
+		std::vector<GLuint> m_indices;
+		std::vector<RenderBatch> m_renderBatches;
+	};
+}
@@ -0,0 +1,130 @@
+#include "StreamBuffer.h"
+#include "ErrManager.h"
+
+namespace ge {
+
+	StreamBuffer::StreamBuffer() { /* empty */ }
+
+	StreamBuffer::~StreamBuffer() { /* empty */ }
+
+	void StreamBuffer::init(GLenum target, GLsizei stride)
+	{
+		m_target = target;
+		m_stride = stride;
+
+		// persistent mapping needs immutable storage
+		m_persistent = GLEW_ARB_buffer_storage != GL_FALSE;
+
+		// start on the last region, so the first map() lands on region 0
+		m_region = NUM_REGIONS - 1;
+	}
+
+	void* StreamBuffer::map(GLsizeiptr size)
+	{
+		if (size > m_regionSize) {
+			// grow at least twice, so a slowly growing scene doesn't reallocate every frame
+			GLsizeiptr newSize = m_regionSize * 2;
+			if (newSize < size) newSize = size;
+			allocate(newSize);
+		}
+
+		m_region = (m_region + 1) % NUM_REGIONS;
+
+		// the GPU may still be reading from the region from NUM_REGIONS draws ago
+		waitFence(m_region);
+
+		if (m_persistent) {
+			return m_mappedPtr + getOffset();
+		}
+
+		GLCall(glBindBuffer(m_target, m_id));
+		void* ptr = nullptr;
+		// no implicit sync, the fence already guarantees the region is free
+		GLCall(ptr = glMapBufferRange(m_target, getOffset(), size,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+		return ptr;
+	}
+
+	void StreamBuffer::unmap()
+	{
+		if (m_persistent) {
+			// coherent mapping, nothing to flush
+			return;
+		}
+
+		GLCall(glBindBuffer(m_target, m_id));
+		GLCall(glUnmapBuffer(m_target));
+		GLCall(glBindBuffer(m_target, 0));
+	}
+
+	void StreamBuffer::fence()
+	{
+		if (m_fences[m_region]) {
+			GLCall(glDeleteSync(m_fences[m_region]));
+		}
+		GLCall(m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+	}
+
+	void StreamBuffer::dispose()
+	{
+		for (int i = 0; i < NUM_REGIONS; i++) {
+			if (m_fences[i]) {
+				GLCall(glDeleteSync(m_fences[i]));
+				m_fences[i] = 0;
+			}
+		}
+
+		if (m_id) {
+			if (m_mappedPtr) {
+				GLCall(glBindBuffer(m_target, m_id));
+				GLCall(glUnmapBuffer(m_target));
+				GLCall(glBindBuffer(m_target, 0));
+				m_mappedPtr = nullptr;
+			}
+			GLCall(glDeleteBuffers(1, &m_id));
+			m_id = 0;
+		}
+		m_regionSize = 0;
+	}
+
+	void StreamBuffer::allocate(GLsizeiptr regionSize)
+	{
+		// keeping the regions aligned to the element size
+		regionSize = ((regionSize + m_stride - 1) / m_stride) * m_stride;
+
+		// the old storage is released by the driver once pending draws are done
+		dispose();
+
+		m_regionSize = regionSize;
+		GLsizeiptr totalSize = m_regionSize * NUM_REGIONS;
+
+		GLCall(glGenBuffers(1, &m_id));
+		GLCall(glBindBuffer(m_target, m_id));
+
+		if (m_persistent) {
+			const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			GLCall(glBufferStorage(m_target, totalSize, nullptr, flags));
+			GLCall(m_mappedPtr = (unsigned char*)glMapBufferRange(m_target, 0, totalSize, flags));
+		}
+		else {
+			GLCall(glBufferData(m_target, totalSize, nullptr, GL_STREAM_DRAW));
+		}
+
+		GLCall(glBindBuffer(m_target, 0));
+	}
+
+	void StreamBuffer::waitFence(int region)
+	{
+		GLsync& sync = m_fences[region];
+		if (!sync) { return; }
+
+		GLenum result = GL_TIMEOUT_EXPIRED;
+		while (result == GL_TIMEOUT_EXPIRED) {
+			// 1 ms steps, flushing so the fence is guaranteed to signal
+			GLCall(result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000));
+		}
+
+		GLCall(glDeleteSync(sync));
+		sync = 0;
+	}
+}
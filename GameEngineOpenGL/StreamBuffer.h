@@ -0,0 +1,58 @@
+#pragma once
+#include <GL\glew.h>
+
+namespace ge {
+
+	/// <summary>
+	/// Triple-buffered ring of GPU-visible memory for streaming per-frame data.
+	/// Uses a persistently mapped buffer (ARB_buffer_storage) when available,
+	/// otherwise falls back to unsynchronized glMapBufferRange.
+	/// Regions are reused only after the fence placed behind their last draw signals.
+	/// </summary>
+	class StreamBuffer
+	{
+	public:
+		StreamBuffer();
+		~StreamBuffer();
+
+		/// <param name="target">GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER...</param>
+		/// <param name="stride">region sizes are kept a multiple of it, so offsets can be turned into element indices</param>
+		void init(GLenum target, GLsizei stride);
+
+		/// <summary>
+		/// Advances to the next region and returns a pointer to write size bytes into.
+		/// May reallocate the buffer, check getId() afterwards if it is referenced by a VAO.
+		/// </summary>
+		void* map(GLsizeiptr size);
+
+		/// must be called after writing and before drawing from the region
+		void unmap();
+
+		/// Places a fence behind the draws that read from the current region
+		void fence();
+
+		/// deletes the buffer and its fences, needs the GL context, so the destructor leaves it to the owner
+		void dispose();
+
+		// getters
+		GLuint getId() const { return m_id; }
+		/// byte offset of the current region
+		GLintptr getOffset() const { return m_region * m_regionSize; }
+		bool isPersistent() const { return m_persistent; }
+
+	private:
+		static const int NUM_REGIONS = 3;
+
+		void allocate(GLsizeiptr regionSize);
+		void waitFence(int region);
+
+		GLuint m_id = 0;
+		GLenum m_target = GL_ARRAY_BUFFER;
+		GLsizei m_stride = 1;
+		GLsizeiptr m_regionSize = 0;
+		int m_region = 0;
+		bool m_persistent = false;
+		unsigned char* m_mappedPtr = nullptr;
+		GLsync m_fences[NUM_REGIONS] = {};
+	};
+}
@@ -1,5 +1,6 @@
 #include "TextureCache.h"
 #include "ImageLoader.h"
+#include "ErrManager.h"
 #include <iostream>
 
 namespace ge {
@@ -13,7 +14,8 @@ namespace ge {
 		if (mit == m_textureMap.end())
 		{
 			// loading the texture and insert to the map
-			GLTexture newTexture = ImageLoader::loadPNG(filePath);
+			GLTexture newTexture = m_atlasPageSize > 0 ?
+				loadAtlasTexture(filePath) : ImageLoader::loadPNG(filePath);
 
 			// adding new pair to the texture map
 			m_textureMap.insert(std::make_pair(filePath, newTexture));
@@ -25,4 +27,151 @@ namespace ge {
 		//std::cout << " Existing texture!\n";
 		return mit->second;
 	}
-}
+
+	GLTexture TextureCache::getLayeredTexture(std::string filePath)
+	{
+		auto mit = m_layerMap.find(filePath);
+		if (mit != m_layerMap.end()) {
+			return mit->second;
+		}
+
+		std::vector<unsigned char> pixels;
+		unsigned long w, h;
+		ImageLoader::decodePNGFile(filePath, pixels, w, h);
+
+		// finding an array of the same size with a free layer
+		TextureArray* texArray = nullptr;
+		for (auto& a : m_textureArrays) {
+			if (a.w == (int)w && a.h == (int)h && a.numLayers < LAYERS_PER_ARRAY) {
+				texArray = &a;
+				break;
+			}
+		}
+
+		if (texArray == nullptr) {
+			TextureArray newArray = {};
+			newArray.w = (int)w;
+			newArray.h = (int)h;
+
+			GLCall(glGenTextures(1, &(newArray.id)));
+			GLCall(glBindTexture(GL_TEXTURE_2D_ARRAY, newArray.id));
+
+			// allocating all the layers, they are filled as textures get requested
+			GLCall(glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, w, h, LAYERS_PER_ARRAY, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+
+			// same parameters as ImageLoader::loadPNG
+			GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT));
+			GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT));
+			GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+			GLCall(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
+
+			m_textureArrays.push_back(newArray);
+			texArray = &m_textureArrays.back();
+		}
+		else {
+			GLCall(glBindTexture(GL_TEXTURE_2D_ARRAY, texArray->id));
+		}
+
+		GLTexture newTexture = {};
+		newTexture.id = texArray->id;
+		newTexture.target = GL_TEXTURE_2D_ARRAY;
+		newTexture.w = (int)w;
+		newTexture.h = (int)h;
+		newTexture.layer = texArray->numLayers++;
+
+		// uploading the image into its layer
+		GLCall(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, newTexture.layer, w, h, 1, GL_RGBA, GL_UNSIGNED_BYTE, &(pixels[0])));
+		GLCall(glGenerateMipmap(GL_TEXTURE_2D_ARRAY));
+
+		// we must always unbind the textures
+		GLCall(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+
+		m_layerMap.insert(std::make_pair(filePath, newTexture));
+		return newTexture;
+	}
+
+	void TextureCache::enableAtlas(int pageSize)
+	{
+		m_atlasPageSize = pageSize;
+	}
+
+	GLTexture TextureCache::loadAtlasTexture(const std::string& filePath)
+	{
+		std::vector<unsigned char> pixels;
+		unsigned long w, h;
+		ImageLoader::decodePNGFile(filePath, pixels, w, h);
+
+		// rounded up to whole blocks, so every image starts on a block and no mipmap texel mixes two images
+		const int paddedW = ((int)w + 3 * ATLAS_PADDING - 1) & ~(ATLAS_PADDING - 1);
+		const int paddedH = ((int)h + 3 * ATLAS_PADDING - 1) & ~(ATLAS_PADDING - 1);
+		if (paddedW > m_atlasPageSize || paddedH > m_atlasPageSize) {
+			return ImageLoader::loadPNG(filePath);
+		}
+
+		// first page with room for it
+		AtlasPage* page = nullptr;
+		glm::ivec2 pos;
+		for (auto& p : m_atlasPages) {
+			if (p.packer.pack(paddedW, paddedH, pos)) {
+				page = &p;
+				break;
+			}
+		}
+
+		if (page == nullptr) {
+			AtlasPage newPage = {};
+			newPage.packer.init(m_atlasPageSize, m_atlasPageSize);
+			newPage.packer.pack(paddedW, paddedH, pos);
+
+			GLCall(glGenTextures(1, &(newPage.id)));
+			GLCall(glBindTexture(GL_TEXTURE_2D, newPage.id));
+			GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_atlasPageSize, m_atlasPageSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+
+			// no wrapping, it would pull in the neighbouring images, and only the mipmaps the padding covers
+			GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+			GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+			GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+			GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
+			GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, ATLAS_MAX_LEVEL));
+
+			m_atlasPages.push_back(newPage);
+			page = &m_atlasPages.back();
+		}
+		else {
+			GLCall(glBindTexture(GL_TEXTURE_2D, page->id));
+		}
+
+		// extruding the edge texels into the padding
+		std::vector<unsigned char> padded(paddedW * paddedH * 4);
+		for (int y = 0; y < paddedH; y++) {
+			int srcY = glm::clamp(y - ATLAS_PADDING, 0, (int)h - 1);
+			for (int x = 0; x < paddedW; x++) {
+				int srcX = glm::clamp(x - ATLAS_PADDING, 0, (int)w - 1);
+				for (int c = 0; c < 4; c++) {
+					padded[(y * paddedW + x) * 4 + c] = pixels[(srcY * w + srcX) * 4 + c];
+				}
+			}
+		}
+
+		GLCall(glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, paddedW, paddedH, GL_RGBA, GL_UNSIGNED_BYTE, &(padded[0])));
+		GLCall(glGenerateMipmap(GL_TEXTURE_2D));
+
+		// we must always unbind the textures
+		GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+
+		GLTexture newTexture = {};
+		newTexture.id = page->id;
+		newTexture.w = (int)w;
+		newTexture.h = (int)h;
+
+		// the shaders sample at 1 - v, so the rect is flipped vertically
+		const float pageSize = (float)m_atlasPageSize;
+		const float top = (pos.y + ATLAS_PADDING) / pageSize;
+		newTexture.uvRect.x = (pos.x + ATLAS_PADDING) / pageSize;
+		newTexture.uvRect.z = w / pageSize;
+		newTexture.uvRect.w = h / pageSize;
+		newTexture.uvRect.y = 1.f - top - newTexture.uvRect.w;
+
+		return newTexture;
+	}
+}
\ No newline at end of file
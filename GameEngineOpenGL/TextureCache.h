@@ -2,7 +2,9 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include "GLTexture.h"
+#include "RectPacker.h"
 
 namespace ge {
 	class TextureCache
@@ -13,9 +15,48 @@ namespace ge {
 		~TextureCache();
 		GLTexture getTexture(std::string filePath);
 
+		/// <summary>
+		/// From now on getTexture packs the textures into shared pageSize*pageSize atlas pages,
+		/// the returned uvRect locates the image in its page. Textures loaded before stay on their own.
+		/// pageSize must be a multiple of 8, the pages are mipmapped down to ATLAS_MAX_LEVEL.
+		/// </summary>
+		void enableAtlas(int pageSize);
+
+		/// <summary>
+		/// Loads the texture into a layer of a GL_TEXTURE_2D_ARRAY shared with
+		/// other textures of the same size. The returned id is the array, layer is set.
+		/// </summary>
+		GLTexture getLayeredTexture(std::string filePath);
+
 	private:
+		/// places the image in an atlas page, or in its own texture if it's bigger than a page
+		GLTexture loadAtlasTexture(const std::string& filePath);
+
+		/// last mipmap level of the atlas pages, a texel of it covers an aligned block of 2^ATLAS_MAX_LEVEL texels
+		static const int ATLAS_MAX_LEVEL = 3;
+		/// border of repeated edge texels around every atlas image, wide enough that neither filtering
+		/// nor the mipmaps up to ATLAS_MAX_LEVEL bleed. Images are also placed on blocks of this size
+		static const int ATLAS_PADDING = 1 << ATLAS_MAX_LEVEL;
+
+		struct AtlasPage {
+			GLuint id;
+			RectPacker packer;
+		};
+
+		/// layers allocated up front for every array, a full array starts a new one
+		static const int LAYERS_PER_ARRAY = 16;
+
+		struct TextureArray {
+			GLuint id;
+			int w, h;
+			int numLayers;
+		};
+
 		std::map<std::string, GLTexture> m_textureMap;
+		std::map<std::string, GLTexture> m_layerMap;
+		std::vector<TextureArray> m_textureArrays;
+		std::vector<AtlasPage> m_atlasPages;
+		int m_atlasPageSize = 0; ///< 0 when the atlas is disabled
 
 	};
 }
-
@@ -0,0 +1,102 @@
+#include "ThreadPool.h"
+
+namespace ge {
+
+	ThreadPool::ThreadPool() : m_next(0)
+	{ /* empty */ }
+
+	ThreadPool::~ThreadPool()
+	{
+		dispose();
+	}
+
+	void ThreadPool::init(size_t numWorkers /* = 0 */)
+	{
+		dispose();
+
+		if (numWorkers == 0) {
+			// hardware_concurrency may not know and return 0
+			const size_t hardwareThreads = std::thread::hardware_concurrency();
+			numWorkers = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+		}
+
+		m_quit = false;
+		// the generation survives dispose(), new workers must not take the last job for a new one
+		for (size_t i = 0; i < numWorkers; i++) {
+			m_workers.emplace_back(&ThreadPool::workerLoop, this, m_generation);
+		}
+	}
+
+	void ThreadPool::dispose()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_quit = true;
+		}
+		m_wake.notify_all();
+
+		for (auto& worker : m_workers) {
+			worker.join();
+		}
+		m_workers.clear();
+	}
+
+	void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& job)
+	{
+		if (count == 0) { return; }
+
+		// nothing to share, skipping the handoff
+		if (m_workers.empty() || count == 1) {
+			for (size_t i = 0; i < count; i++) {
+				job(i);
+			}
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_job = &job;
+			m_count = count;
+			m_next = 0;
+			m_busyWorkers = m_workers.size();
+			m_generation++;
+		}
+		m_wake.notify_all();
+
+		runJobs();
+
+		// the job lives on the caller's stack, so every worker must be done with it
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done.wait(lock, [this]() { return m_busyWorkers == 0; });
+		m_job = nullptr;
+	}
+
+	void ThreadPool::workerLoop(size_t seenGeneration)
+	{
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [&]() { return m_quit || m_generation != seenGeneration; });
+				if (m_quit) { return; }
+				seenGeneration = m_generation;
+			}
+
+			runJobs();
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_busyWorkers--;
+			}
+			m_done.notify_one();
+		}
+	}
+
+	void ThreadPool::runJobs()
+	{
+		const std::function<void(size_t)>& job = *m_job;
+		for (size_t i = m_next++; i < m_count; i = m_next++) {
+			job(i);
+		}
+	}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+namespace ge {
+
+	/// <summary>
+	/// Worker threads that sleep until parallelFor hands them jobs. Meant to be shared,
+	/// e.g. by ParticleEngine2D and game systems filling SpriteSubmitBuffers
+	/// </summary>
+	class ThreadPool
+	{
+	public:
+		ThreadPool();
+		~ThreadPool();
+
+		/// <summary>
+		/// starts the workers
+		/// </summary>
+		/// <param name="numWorkers">0 for one less than the hardware threads, the caller of parallelFor is the last one</param>
+		void init(size_t numWorkers = 0);
+		/// joins the workers, parallelFor then runs everything on the caller
+		void dispose();
+
+		/// <summary>
+		/// runs job(i) for every i in [0, count) on the workers and the calling thread, returns once all are done.
+		/// Which thread runs which index is up to the scheduling, jobs must not depend on it.
+		/// Not reentrant, a job must not call parallelFor
+		/// </summary>
+		void parallelFor(size_t count, const std::function<void(size_t)>& job);
+
+		/// threads parallelFor runs on, the caller included
+		size_t getNumThreads() const { return m_workers.size() + 1; }
+
+	private:
+		/// <param name="seenGeneration">m_generation when the worker was started</param>
+		void workerLoop(size_t seenGeneration);
+		/// takes indices of the current job until there are none left
+		void runJobs();
+
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable m_wake; ///< a new job or quitting
+		std::condition_variable m_done; ///< a worker finished the current job
+
+		const std::function<void(size_t)>* m_job = nullptr;
+		size_t m_count = 0;
+		std::atomic<size_t> m_next;
+		size_t m_generation = 0; ///< bumped for every parallelFor, so workers tell new jobs from spurious wakeups
+		size_t m_busyWorkers = 0;
+		bool m_quit = false;
+	};
+
+}
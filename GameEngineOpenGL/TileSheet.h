@@ -22,7 +22,7 @@ namespace ge
 			uv.y = yTile / (float)dims.y;
 			uv.z = 1.0f / (float)dims.x;
 			uv.w = 1.0f / (float)dims.y;
-			return uv;
+			return texture.subUV(uv);
 		}
 
 	public:
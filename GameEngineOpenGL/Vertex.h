@@ -59,4 +59,42 @@ namespace ge {
 		void setColor(GLubyte r, GLubyte g, GLubyte b, GLubyte alpha) { color = ColorRGBA8(r,  g,  b,  alpha); }
 		void setUV(float u, float v) { uv = UV(u, v); }
 	};
+
+	/// <summary>
+	/// Located in Vertex.h, Vertex sampling a GL_TEXTURE_2D_ARRAY layer
+	/// </summary>
+	struct LayeredVertex
+	{
+		Position pos;
+		ColorRGBA8 color;
+		UV uv;
+		GLuint layer;
+	};
+
+	/// <summary>
+	/// Located in Vertex.h, Vertex of VertexFormat::DEPTH, the depth follows
+	/// the position so the shader reads them as one vec3
+	/// </summary>
+	struct DepthVertex
+	{
+		Position pos;
+		GLfloat depth;
+		ColorRGBA8 color;
+		UV uv;
+	};
+
+	/// <summary>
+	/// Located in Vertex.h, 12 byte vertex of VertexFormat::COMPACT.
+	/// Positions are fixed point offsets from the batch origin in 1/8 units, so
+	/// they snap to 0.125 and reach +-4096 units from it (further ones are clamped).
+	/// UVs are normalized to 1/65535 steps and limited to [0, 1], no repeating.
+	/// </summary>
+	struct CompactVertex
+	{
+		static const int POSITION_SUBSTEPS = 8;
+
+		GLshort x, y;
+		ColorRGBA8 color;
+		GLushort u, v;
+	};
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Window.h"
 #include "ErrManager.h"
+#include "RenderStats.h"
 
 
 namespace ge {
@@ -70,6 +71,9 @@ namespace ge {
 	{
 		// Flushing current screen
 		SDL_GL_SwapWindow(m_sdlWindow);
+
+		// a swap ends the frame for the render stats
+		RenderStats::endFrame();
 	}
 
 }
\ No newline at end of file
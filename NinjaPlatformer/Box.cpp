@@ -59,7 +59,7 @@ void Box::destroy(b2World * world)
 void Box::draw(ge::SpriteBatch& spriteBatch)
 {
 	spriteBatch.draw(this->getDestRect(), m_uvRect,
-		m_texture2D.id, 0.0f, m_color, m_body->GetAngle());
+		m_texture2D, 0.0f, m_color, m_body->GetAngle());
 }
 
 glm::vec4 Box::getDestRect() const
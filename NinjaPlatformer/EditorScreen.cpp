@@ -44,12 +44,19 @@ void EditorScreen::onEntry()
 	initShaders();
 	m_spriteBatch.init();
 	m_blankTexture = ge::ResourceManager::getTexture("Assets/blank.png");
+
+	// placed and colored by draw()
+	m_staticBatch.init();
+	m_colorQuad = m_staticBatch.add(glm::vec4(0.0f), glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), m_blankTexture, 0.0f, ge::ColorRGBA8());
 }
 
 void EditorScreen::onExit()
 {
 	m_gui.destroy();
 	m_textureProgram.dispose();
+	m_spriteBatch.dispose();
+	m_staticBatch.clear();
+	m_staticBatch.dispose();
 }
 
 void EditorScreen::update()
@@ -101,7 +108,8 @@ void EditorScreen::draw()
 		auto uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
 		auto color = ge::ColorRGBA8((GLubyte)m_rColorVal, (GLubyte)m_gColorVal, (GLubyte)m_bColorVal, 255);
 
-		m_spriteBatch.draw(destRect, uvRect, m_blankTexture.id, 0.0f, color);
+		// no upload unless the sliders moved
+		m_staticBatch.update(m_colorQuad, destRect, m_blankTexture.subUV(uvRect), color);
 	}
 
 	// drawing radio button lables
@@ -119,6 +127,8 @@ void EditorScreen::draw()
 	}
 
 	m_spriteBatch.end();
+	// the color quad first, under the labels, as when it was drawn into m_spriteBatch before them
+	m_staticBatch.renderBatch();
 	m_spriteBatch.renderBatch();
 	m_textureProgram.unuse();
 
@@ -3,6 +3,7 @@
 #include <GameEngineOpenGL\Window.h>
 #include <GameEngineOpenGL\Camera2D.h>
 #include <GameEngineOpenGL\SpriteBatch.h>
+#include <GameEngineOpenGL\StaticSpriteBatch.h>
 #include <GameEngineOpenGL\SpriteFont.h>
 #include <GameEngineOpenGL\GLSLProgram.h>
 #include <GameEngineOpenGL\GLTexture.h>
@@ -50,6 +51,8 @@ private:
 	ge::GUI m_gui;
 	ge::Camera2D m_camera; // Renders the scene
 	ge::SpriteBatch m_spriteBatch;
+	ge::StaticSpriteBatch m_staticBatch; // Only re-uploaded when the picked color changes
+	ge::SpriteHandle m_colorQuad = 0;
 	ge::SpriteFont m_spriteFont;
 	ge::GLSLProgram m_textureProgram;// Shader for the textures
 	ge::GLTexture m_blankTexture;
@@ -6,6 +6,9 @@
 #include <iostream>
 #include "ScreenIndices.h"
 
+// sprite batch layers, the debug rendering goes in between
+const uint8_t LAYER_WORLD = 0;
+const uint8_t LAYER_LIGHTS = 1;
 
 GameplayScreen::GameplayScreen(ge::Window* window)
 	: m_window(window)
@@ -49,6 +52,7 @@ void GameplayScreen::onEntry()
 void GameplayScreen::onExit()
 {
 	m_debugRenderer.dispose();
+	m_spriteBatch.dispose();
 	m_gui.destroy();
 
 }
@@ -86,8 +90,15 @@ void GameplayScreen::draw()
 	// uploading the camera matrix to the GPU
 	glUniformMatrix4fv(pLocation, 1, GL_FALSE, &projectionMatrix[0][0]);
 
-	// Rendering the boxes and the player
-#pragma region Rendering the boxes and the player
+	// the light program keeps its own uniforms, the sprite batch only switches to it
+	m_lightProgram.use();
+	pLocation = m_lightProgram.getUniformLocation("P");
+	glUniformMatrix4fv(pLocation, 1, GL_FALSE, &projectionMatrix[0][0]);
+	m_textureProgram.use();
+
+	// The boxes, the player and the lights share one batch. The lights have their own
+	// material and layer, so they are drawn after the debug rendering and end up on top
+#pragma region Rendering the boxes, the player and the lights
 
 	m_spriteBatch.begin();
 
@@ -98,10 +109,20 @@ void GameplayScreen::draw()
 
 	m_player.draw(m_spriteBatch);
 
+	m_spriteBatch.setRenderLayer(LAYER_LIGHTS);
+
+	// drawing player light
+	m_playerLight.pos = m_player.getPos();
+	m_playerLight.draw(m_spriteBatch, m_lightMaterial);
+
+	// drawing mouse light
+	m_mouseLight.pos = m_camera.covertScreenToWorld(m_game->inputManager.getMouseCoords());
+	m_mouseLight.draw(m_spriteBatch, m_lightMaterial);
+
 	m_spriteBatch.end();
-	m_spriteBatch.renderBatch();
+	m_spriteBatch.renderLayer(LAYER_WORLD);
 	m_textureProgram.unuse();
-#pragma endregion // Rendering the boxes and the player
+#pragma endregion // Rendering the boxes, the player and the lights
 
 	// Debug rendering...
 #pragma region Debug rendering...
@@ -121,34 +142,8 @@ void GameplayScreen::draw()
 	}
 #pragma endregion // Debug rendering...
 
-	// Render test lights
-#pragma region Render test lights
-
-	m_lightProgram.use();
-	pLocation = m_lightProgram.getUniformLocation("P");
-	glUniformMatrix4fv(pLocation, 1, GL_FALSE, &projectionMatrix[0][0]);
-
-	// additive blending
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-
-	m_spriteBatch.begin();
-
-	// drawing player light
-	m_playerLight.pos = m_player.getPos();
-	m_playerLight.draw(m_spriteBatch);
-
-	// drawing mouse light
-	m_mouseLight.pos = m_camera.covertScreenToWorld(m_game->inputManager.getMouseCoords());
-	m_mouseLight.draw(m_spriteBatch);
-
-	m_spriteBatch.end();
-	m_spriteBatch.renderBatch();
-	m_lightProgram.unuse();
-
-	// reset blending
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-#pragma endregion // Render test lights
+	// the lights, on top of the debug rendering
+	m_spriteBatch.renderLayer(LAYER_LIGHTS);
 
 	m_gui.draw();
 
@@ -229,6 +224,8 @@ void GameplayScreen::initShaders()
 	m_lightProgram.addAttribute("vertexColor");
 	m_lightProgram.addAttribute("vertexUV");
 	m_lightProgram.linkShaders();
+
+	m_lightMaterial = ge::Material(&m_lightProgram, 0, ge::BlendMode::ADDITIVE);
 }
 
 void GameplayScreen::initLights()
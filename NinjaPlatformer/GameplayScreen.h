@@ -57,6 +57,7 @@ private:
 	ge::Window* m_window = nullptr;	
 	ge::GLSLProgram m_textureProgram;// Shader for the textures	
 	ge::GLSLProgram m_lightProgram;// Shader for the lights
+	ge::Material m_lightMaterial; // Light program, additive blending
 	ge::DebugRenderer m_debugRenderer;
 	ge::GUI m_gui;
 
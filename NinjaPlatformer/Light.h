@@ -7,7 +7,8 @@ class Light
 {
 
 public:
-	void draw(ge::SpriteBatch& spriteBatch) {
+	/// material is the light program with additive blending, its texture is unused
+	void draw(ge::SpriteBatch& spriteBatch, const ge::Material& material) {
 		glm::vec4 destRect;
 		auto uvRect = glm::vec4(-1.0f, -1.0f, 2.0f, 2.0f);
 
@@ -16,7 +17,7 @@ public:
 		destRect.z = size;
 		destRect.w = size;
 
-		spriteBatch.draw(destRect, uvRect, 0, 0.f, color, 0.0f);
+		spriteBatch.draw(destRect, uvRect, material, 0.f, color, 0.0f);
 	}
 
 		
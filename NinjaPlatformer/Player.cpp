@@ -103,7 +103,7 @@ void Player::draw(ge::SpriteBatch& spriteBatch)
 
 	// left <-> right
 	if (m_dir == -1) {
-		uvRect.x += 1.0f / m_tileSheet.dims.x;
+		uvRect.x += uvRect.z;
 		uvRect.z *= -1.0f;
 	}
 
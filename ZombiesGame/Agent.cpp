@@ -1,5 +1,6 @@
 #include "Agent.h"
 #include <GameEngineOpenGL\ResourceManager.h>
+#include <GameEngineOpenGL\QuadTransform.h>
 #include <algorithm> 
 #include <iostream>
 
@@ -81,11 +82,20 @@ bool Agent::collideWithAgent(Agent * agent)
 
 void Agent::draw(ge::SpriteBatch & spriteBatch)
 {
-	const auto uvRect = glm::vec4(0.f, 0.f, 1.f, 1.f);
-	glm::vec4 destRect(m_pos.x , m_pos.y, AGENT_WIDTH, AGENT_WIDTH);
+	const ge::SpriteInstance sprite = getSpriteInstance();
 
 	// drawing
-	spriteBatch.draw(destRect, uvRect, m_textureId, 0.f, m_color, m_dir);
+	spriteBatch.draw(sprite.destRect, sprite.uvRect, m_texture.id, 0.f, sprite.color, m_dir);
+}
+
+ge::SpriteInstance Agent::getSpriteInstance() const
+{
+	ge::SpriteInstance sprite;
+	sprite.destRect = glm::vec4(m_pos.x, m_pos.y, AGENT_WIDTH, AGENT_WIDTH);
+	sprite.uvRect = m_texture.subUV(glm::vec4(0.f, 0.f, 1.f, 1.f));
+	sprite.color = m_color;
+	sprite.rotation = ge::rotationFromDir(m_dir);
+	return sprite;
 }
 
 bool Agent::applyDamage(float damage)
@@ -33,6 +33,11 @@ public:
 
 	void draw(ge::SpriteBatch& spriteBatch);
 
+	/// <summary>
+	/// the sprite draw() submits, for handing many agents to SpriteBatch::drawMany
+	/// </summary>
+	ge::SpriteInstance getSpriteInstance() const;
+
 	/// <summary>
 	/// /returning true if agent died
 	/// </summary>
@@ -46,6 +51,7 @@ public:
 	// getters
 	glm::vec2 getPos() const { return m_pos; }
 	const float getRadius() const { return m_radius; }
+	GLuint getTextureId() const { return m_texture.id; }
 protected:
 
 	void collideWidthTile(const glm::vec2& tilePos);
@@ -60,6 +66,6 @@ protected:
 	int m_numLives;
 	const float m_radius = 20.f;
 	ge::ColorRGBA8 m_color; 
-	GLuint m_textureId;
+	ge::GLTexture m_texture;
 };
 
@@ -27,7 +27,7 @@ bool Bullet::update(const std::vector<std::string>& lvlData, float deltaTime)
 
 void Bullet::draw(ge::SpriteBatch& spriteBatch)
 {
-	static int texId = ge::ResourceManager::getTexture("Textures/agent.png").id;
+	static auto texture = ge::ResourceManager::getTexture("Textures/agent.png");
 
 	auto destRect = glm::vec4 (m_pos.x , m_pos.y ,
 		BULLET_WIDTH, BULLET_WIDTH);
@@ -36,7 +36,7 @@ void Bullet::draw(ge::SpriteBatch& spriteBatch)
 
 	auto color = ge::ColorRGBA8(75, 75, 75, 255);
 	// drawing
-	spriteBatch.draw(destRect, uvRect, texId, 0.f, color);
+	spriteBatch.draw(destRect, uvRect, texture, 0.f, color);
 }
 
 bool Bullet::collideWithAgent(Agent * agent)
@@ -33,7 +33,7 @@ void Human::init(glm::vec2 initialPos, float initialSpeed)
 	}
 
 	this->m_dir = glm::normalize(this->m_dir);
-	m_textureId = ge::ResourceManager::getTexture("Textures/human.png").id;
+	m_texture = ge::ResourceManager::getTexture("Textures/human.png");
 }
 
 void Human::update(const std::vector<std::string>& lvlData,
@@ -30,7 +30,6 @@ Level::Level(const std::string & filePath)
 	}
 
 	m_spriteBatch.init();
-	m_spriteBatch.begin();
 	
 	const auto uvRect = glm::vec4(0.f, 0.f, 1.f, 1.f);
 	ge::ColorRGBA8 color;
@@ -58,23 +57,23 @@ Level::Level(const std::string & filePath)
 				m_levelData[y][x] = '.'; // changing back to empty space
 				break;
 			case 'L':
-				m_spriteBatch.draw(destRect, uvRect,
-					rm::getTexture("Textures/L_bricks.png").id,
+				m_spriteBatch.add(destRect, uvRect,
+					rm::getTexture("Textures/L_bricks.png"),
 					0.f, color);
 				break;
 			case 'B':
-				m_spriteBatch.draw(destRect, uvRect,
-					rm::getTexture("Textures/B_bricks.png").id,
+				m_spriteBatch.add(destRect, uvRect,
+					rm::getTexture("Textures/B_bricks.png"),
 					0.f, color);
 				break;
 			case 'R':
-				m_spriteBatch.draw(destRect, uvRect,
-					rm::getTexture("Textures/R_bricks.png").id,
+				m_spriteBatch.add(destRect, uvRect,
+					rm::getTexture("Textures/R_bricks.png"),
 					0.f, color);
 				break;
 			case 'G':
-				m_spriteBatch.draw(destRect, uvRect,
-					rm::getTexture("Textures/G_bricks.png").id,
+				m_spriteBatch.add(destRect, uvRect,
+					rm::getTexture("Textures/G_bricks.png"),
 					0.f, color);
 				break;
 			case '.':
@@ -85,8 +84,6 @@ Level::Level(const std::string & filePath)
 			}
 		}
 	}
-
-	m_spriteBatch.end();
 }
 
 Level::~Level() { /* empty */ }
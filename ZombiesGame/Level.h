@@ -1,7 +1,7 @@
 #pragma once
 #include <string>
 #include <vector>
-#include <GameEngineOpenGL\SpriteBatch.h>
+#include <GameEngineOpenGL\StaticSpriteBatch.h>
 
 const float TILE_WITH = 64.f;
 const float TILE_RADIUS = TILE_WITH / 2.f;
@@ -25,7 +25,7 @@ public:
 private:
 
 	std::vector<std::string> m_levelData;
-	ge::SpriteBatch m_spriteBatch;
+	ge::StaticSpriteBatch m_spriteBatch; ///< the tiles never change, uploaded once
 
 	glm::vec2 m_playerStartPos;
 	std::vector<glm::vec2> m_zombiesStartPos;
@@ -20,7 +20,7 @@ Player::Player(glm::vec2 position, glm::vec2 direction,
 
 	// hardcoded color blue
 	m_color.setColor(255, 255, 255, 255);
-	m_textureId = ge::ResourceManager::getTexture("Textures/player.png").id;
+	m_texture = ge::ResourceManager::getTexture("Textures/player.png");
 }
 
 
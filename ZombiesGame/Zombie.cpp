@@ -15,7 +15,7 @@ void Zombie::init(glm::vec2 initialPos, float initialSpeed)
 	this->m_speed = initialSpeed;
 	this->m_color.setColor(255, 255, 255, 255);
 	this->m_health = 20.f;
-	m_textureId = ge::ResourceManager::getTexture("Textures/zombie.png").id;
+	m_texture = ge::ResourceManager::getTexture("Textures/zombie.png");
 }
 
 void Zombie::update(const std::vector<std::string>& lvlData,
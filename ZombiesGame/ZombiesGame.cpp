@@ -22,6 +22,10 @@ const float MAX_DELTA_TIME = 1;
 const float MILLISEC_PER_SEC = 1000.f;
 const float CAMERA_SCALE = 1.f / 2.5f;
 
+// render queue layers, drawn in this order, the particles go in between
+const uint8_t LAYER_AGENTS = 0;
+const uint8_t LAYER_HUD = 1;
+
 ZombiesGame::ZombiesGame() :
 	m_gameState(GameState::PLAY),
 	scrW(1366),
@@ -61,6 +65,10 @@ void ZombiesGame::run()
 	music.play(-1);
 
 	gameLoop();
+
+	// while the GL context is still alive
+	m_renderQueue.dispose();
+	m_particleRenderer.dispose();
 }
 
 void ZombiesGame::initSystems()
@@ -80,10 +88,19 @@ void ZombiesGame::initSystems()
 	m_window.create("Zombies Game", scrW, scrH, ge::WINDOW_SHOWN);
 	glClearColor(0.7f, 0.7f, 0.7f, 1.0f); // light gray background
 
+	// agents, bullets and particles all fit in one atlas page, so they batch together
+	ge::ResourceManager::enableTextureAtlas();
+
 	// Calling program to compile the shaders
 	initShaders();
-	m_agentSpriteBatch.init();
-	m_hudSpriteBatch.init();
+	// agents and hud text share one sort and one upload per frame,
+	// off screen agents and bullets are dropped by the queue
+	m_renderQueue.init(ge::VertexUpload::STREAMING);
+	m_renderQueue.setLayer(LAYER_AGENTS, &m_camera2D, &m_colorProgram, true);
+	m_renderQueue.setLayer(LAYER_HUD, &m_hudCamera, &m_colorProgram);
+
+	// the particles skip the sprite batch, their arrays are drawn as they are
+	m_particleRenderer.init();
 
 	// initializing sprite font 
 	// ( must be initialized after initializing SDL, OpenGL and shaders )
@@ -93,9 +110,7 @@ void ZombiesGame::initSystems()
 	m_bloodParticleBatch = new ge::ParticleBatch2D();
 	m_bloodParticleBatch->init( 1000, 0.05f, 
 		ge::ResourceManager::getTexture("Textures/particle.png"),
-		[] (ge::Particle2D& p, float deltaTime)  
-			{ p.pos += p.velocity * deltaTime; 
-			  p.color.a = (GLubyte)(p.life * 255.f); }); // lampda for blood particles custom behavior
+		ge::ParticleIntegration::MOVE_AND_FADE); // blood moves and fades out with its life
 
 	m_particleEngine.addParticleBatch(m_bloodParticleBatch);
 
@@ -442,38 +457,31 @@ void ZombiesGame::drawGame()
 	// draw level
 	m_levels[m_currLvl]->draw();
 	
-	m_agentSpriteBatch.begin();
+	m_renderQueue.begin();
 
-	const glm::vec2 agentDims(AGENT_RADIUS * 2.f);
+	ge::SpriteBatch& agentBatch = m_renderQueue.submit(LAYER_AGENTS);
 
 	// draw humans, including draw player
-	for (size_t i = 0; i < m_humans.size(); i++) {
-
-		if (m_camera2D.isInView(m_humans[i]->getPos(), agentDims)) {
-			m_humans[i]->draw(m_agentSpriteBatch);
-		}
-	}
+	drawAgents(agentBatch, m_humans);
 	
 	// draw zombies
-	for (size_t i = 0; i < m_zombies.size(); i++) {
-		if (m_camera2D.isInView(m_zombies[i]->getPos(), agentDims)) {
-			m_zombies[i]->draw(m_agentSpriteBatch);
-		}
-	}
+	drawAgents(agentBatch, m_zombies);
 
 	// draw bullets
 	for (size_t i = 0; i < m_bullets.size(); i++) {
-		m_bullets[i].draw(m_agentSpriteBatch);
+		m_bullets[i].draw(agentBatch);
 	}
 
-	// drawing the agents
-	m_agentSpriteBatch.end();
-	m_agentSpriteBatch.renderBatch();
+	drawHud(m_renderQueue.submit(LAYER_HUD));  // drawing text on the screen
 
-	// Render the particles, reusing agents sprite batch
-	m_particleEngine.draw(&m_agentSpriteBatch);
+	// drawing everything, each layer with its camera
+	m_renderQueue.end();
+	m_renderQueue.renderLayers(LAYER_AGENTS, LAYER_AGENTS);
 
-	drawHud();  // drawing text on the screen
+	// the particles, above the agents
+	m_particleEngine.render(&m_particleRenderer, cameraMatrix);
+
+	m_renderQueue.renderLayers(LAYER_HUD, LAYER_HUD);
 
 	m_colorProgram.unuse();
 
@@ -481,31 +489,40 @@ void ZombiesGame::drawGame()
 	m_window.swapBuffer();
 }
 
-void ZombiesGame::drawHud()
+template<typename T>
+void ZombiesGame::drawAgents(ge::SpriteBatch& spriteBatch, const std::vector<T*>& agents)
 {
-	char buffer[256];
-
-	// set the camera matrix and pass it ot shader
-	GLint pLocation = m_colorProgram.getUniformLocation("P");
-
-	// grab the camera matrix
-	glm::mat4 cameraMatrix = m_hudCamera.getCameraMatrix();
+	// one drawMany per run of agents sharing a texture instead of a draw per agent
+	size_t runStart = 0;
+	for (size_t i = 0; i <= agents.size(); i++) {
+		if (i < agents.size() && agents[i]->getTextureId() == agents[runStart]->getTextureId()) {
+			continue;
+		}
+		if (i > runStart) {
+			m_agentInstances.clear();
+			for (size_t a = runStart; a < i; a++) {
+				m_agentInstances.push_back(agents[a]->getSpriteInstance());
+			}
+			spriteBatch.drawMany(m_agentInstances.data(), m_agentInstances.size(),
+				agents[runStart]->getTextureId());
+		}
+		runStart = i;
+	}
+}
 
-	// uploading the camera matrix to the GPU
-	glUniformMatrix4fv(pLocation, 1, GL_FALSE, &(cameraMatrix[0][0]));
+void ZombiesGame::drawHud(ge::SpriteBatch& spriteBatch)
+{
+	char buffer[256];
 
-	m_hudSpriteBatch.begin();
+	// the hud camera is set by the render queue layer
 
 	sprintf_s(buffer, "Num Humans %d", m_humans.size());
-	m_spriteFont->draw(m_hudSpriteBatch, buffer, glm::vec2(0, 0), 
+	m_spriteFont->draw(spriteBatch, buffer, glm::vec2(0, 0), 
 		glm::vec2(1.0f), 0.f, ge::ColorRGBA8(255, 255, 255, 255));
 
 	sprintf_s(buffer, "Num Zombies %d", m_zombies.size());
-	m_spriteFont->draw(m_hudSpriteBatch, buffer, glm::vec2(0, 32),
+	m_spriteFont->draw(spriteBatch, buffer, glm::vec2(0, 32),
 		glm::vec2(1.f), 0.f, ge::ColorRGBA8(255, 255, 255, 255));
-
-	m_hudSpriteBatch.end();
-	m_hudSpriteBatch.renderBatch();
 }
 
 void ZombiesGame::addBlood(const glm::vec2& position, int numParticles)
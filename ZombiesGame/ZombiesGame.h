@@ -6,10 +6,12 @@
 #include <GameEngineOpenGL\GLSLProgram.h>
 #include <GameEngineOpenGL\Timing.h>
 #include <GameEngineOpenGL\SpriteBatch.h>
+#include <GameEngineOpenGL\RenderQueue.h>
 #include <GameEngineOpenGL\SpriteFont.h>
 #include <GameEngineOpenGL\AudioManager.h>
 #include <GameEngineOpenGL\ParticleEngine2D.h>
 #include <GameEngineOpenGL\ParticleBatch2D.h>
+#include <GameEngineOpenGL\ParticleRenderer2D.h>
 
 #include "Level.h"
 #include "Player.h"
@@ -35,16 +37,19 @@ public:
 	void checkVictory();
 	void processInput();
 	void drawGame();
-	void drawHud();
+	/// submits humans or zombies to spriteBatch in bulk
+	template<typename T>
+	void drawAgents(ge::SpriteBatch& spriteBatch, const std::vector<T*>& agents);
+	void drawHud(ge::SpriteBatch& spriteBatch);
 	void addBlood(const glm::vec2& position, int numParticles);
 
 private:
 	ge::Window m_window;
 	ge::Camera2D m_camera2D;
 	ge::Camera2D m_hudCamera;
-	ge::SpriteBatch m_agentSpriteBatch; /// to draw all agents
-	ge::SpriteBatch m_hudSpriteBatch; /// to draw hud text
+	ge::RenderQueue m_renderQueue; /// to draw all agents and hud text
 	ge::ParticleEngine2D m_particleEngine;
+	ge::ParticleRenderer2D m_particleRenderer; /// draws the particles between the agents and the hud
 	ge::ParticleBatch2D* m_bloodParticleBatch = nullptr;
 
 	ge::InputManager m_inputManager;
@@ -64,6 +69,7 @@ private:
 	std::vector<Human*> m_humans; ///< vector of all humans
 	std::vector<Zombie*> m_zombies; ///< vector of all zombies
 	std::vector<Bullet> m_bullets; ///< vector of all bullets
+	std::vector<ge::SpriteInstance> m_agentInstances; ///< reused by drawAgents every frame
 
 	int m_humansKilled;
 	int m_zombiesKilled;